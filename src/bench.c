@@ -0,0 +1,1372 @@
+// Benchmarks and checks, every input is generated from fixed seed so runs can be compared
+// Build: cc -O2 -std=c99 bench.c -o bench (add -DSA_ENABLE_THREADS -pthread for threads)
+// Run: ./bench [scale], scale multiplies input sizes, exit code is 1 when any check fails
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+// For clock_gettime
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "test_spirvsba.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+
+// Every timing is the best of that many runs
+#define BENCH_RUNS 5
+
+static sa_uint32_t failures = 0;
+static sa_uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+typedef struct text_s {
+  char* pData;
+  sa_uint32_t size;
+  sa_uint32_t capacity;
+} text_t;
+
+static double seconds() {
+  return (double)clock() / CLOCKS_PER_SEC;
+}
+
+// Wall time, clock() adds up time of every thread on POSIX (on Windows it already is wall time)
+static double wallSeconds() {
+#if defined(_WIN32)
+  return (double)clock() / CLOCKS_PER_SEC;
+#else
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+
+  return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+}
+
+static sa_uint32_t nextRandom() {
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+  return (sa_uint32_t)(seed >> 32);
+}
+
+static void check(sa_bool ok, const char* what) {
+  if(!ok) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void appendText(text_t* pText, const char* fmt, ...) {
+  va_list args;
+
+  va_start(args, fmt);
+  const sa_uint32_t length = (sa_uint32_t)vsnprintf(SA_NULL, 0, fmt, args);
+  va_end(args);
+
+  // Null terminator is written too
+  while(pText->capacity - pText->size <= length) {
+    pText->capacity = pText->capacity * 2 + 4096;
+    pText->pData = (char*)realloc(pText->pData, pText->capacity);
+  }
+
+  va_start(args, fmt);
+  vsnprintf(pText->pData + pText->size, pText->capacity - pText->size, fmt, args);
+  va_end(args);
+
+  pText->size += length;
+}
+
+static void freeText(text_t* pText) {
+  free(pText->pData);
+  sa__setMemory(pText, 0, sizeof(*pText));
+}
+
+/**
+ * @brief Makes .spa module with one small function per block, every block has 5 ids of its own
+ *
+ * @param pText
+ * @param blockCount
+ * @param comments adds comment line and indentation to every block
+ */
+static void makeModule(text_t* pText, sa_uint32_t blockCount, sa_bool comments) {
+  appendText(pText, "TypeVoid %%void\nTypeFunction %%fnT %%void\nTypeInt %%u32 32 0\nTypePointer %%ptr Function %%u32\n");
+
+  for(sa_uint32_t i = 0; i < blockCount; i++) {
+    if(comments)
+      appendText(pText, "; Function %u adds constant to itself\n", i);
+
+    appendText(pText, "Decorate %%v%u Location %u\nFunction %%void %%fn%u None %%fnT\n%sLabel %%l%u\n%sConstant %%u32 %%k%u %u\n%sVariable %%ptr %%v%u Function\n%sIAdd %%u32 %%s%u %%k%u %%k%u\n%sReturn\nFunctionEnd\n",
+      i, i, i, comments ? "  " : "", i, comments ? "  " : "", i, i, comments ? "  " : "", i, comments ? "  " : "", i, i, i, comments ? "  " : "");
+  }
+}
+
+static sa_uint32_t instructionCount(const sa_assembly_t* pAsm) {
+  sa_uint32_t count = 0;
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++)
+    count += pAsm->section[sect].instCount;
+
+  return count;
+}
+
+//
+// Id table, time per id has to stay the same as module grows
+//
+
+static void benchIds(sa_uint32_t scale) {
+  puts("ids:");
+
+  for(sa_uint32_t blockCount = 2500 * scale; blockCount <= 40000 * scale; blockCount *= 4) {
+    text_t text = {0};
+    makeModule(&text, blockCount, SA_FALSE);
+
+    sa_context_t ctx;
+    sa_initContext(&ctx);
+
+    double best = 1e9;
+    sa_uint32_t bound = 0;
+
+    for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+      sa_assembly_t spirvAsm = {0};
+
+      double start = seconds();
+      sa_assembleSPIRVN(&ctx, text.pData, text.size, &spirvAsm);
+      double time = seconds() - start;
+
+      if(time < best)
+        best = time;
+
+      bound = spirvAsm.header.bounds;
+      sa_freeAssembly(&spirvAsm);
+    }
+
+    printf("  %7u ids: %8.2f ms, %6.1f ns per id\n", bound - 1, best * 1e3, best * 1e9 / (bound - 1));
+    check(ctx.diagnostics.errorCount == 0, "generated module has errors");
+    check(bound == blockCount * 5 + 5, "id bound does not match generated ids");
+
+    sa_freeContext(&ctx);
+    freeText(&text);
+  }
+}
+
+//
+// Baking, module has over 1M words
+//
+
+static void benchBake(sa_uint32_t scale) {
+  puts("bake:");
+
+  text_t text = {0};
+  makeModule(&text, 25000 * scale, SA_FALSE);
+
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  sa_assembly_t spirvAsm = {0};
+  sa_assembleSPIRVN(&ctx, text.pData, text.size, &spirvAsm);
+
+  sa_uint32_t directSize = 0;
+  sa_uint8_t* pDirect = sa_assembleToBinary(&ctx, text.pData, text.size, &directSize);
+
+  double best = 1e9;
+  sa_uint32_t binarySize = 0;
+
+  for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+    double start = seconds();
+    sa_uint8_t* pBinary = sa_bakeSPIRV(&ctx, &spirvAsm, &binarySize);
+    double time = seconds() - start;
+
+    if(time < best)
+      best = time;
+
+    if(run == 0)
+      check(pDirect && binarySize == directSize && memcmp(pBinary, pDirect, binarySize) == 0, "baked binary differs from sa_assembleToBinary");
+
+    sa_freeSPIRV(pBinary);
+  }
+
+  const sa_uint32_t insts = instructionCount(&spirvAsm);
+
+  printf("  %u words, %u instructions: %.2f ms, %.1f ns per instruction, %.0f MB/s\n", binarySize / 4, insts, best * 1e3, best * 1e9 / insts, binarySize / 1e6 / best);
+  check(binarySize / 4 >= 1000000, "module is smaller than 1M words");
+  check(ctx.diagnostics.errorCount == 0, "generated module has errors");
+
+  sa_freeSPIRV(pDirect);
+  sa_freeAssembly(&spirvAsm);
+  sa_freeContext(&ctx);
+  freeText(&text);
+}
+
+//
+// Assembling straight to binary, bytes and errors have to be the same as from sa_assembleSPIRVN followed by sa_bakeSPIRV
+//
+
+// Shader with entry point, names, decorations, constants and function with body
+static const char* SPA_SHADER =
+  "; Light shader\n"
+  "ExtInstImport %glsl \"GLSL.std.450\"\n"
+  "\n"
+  "EntryPoint GLCompute %main \"main\"\n"
+  "ExecutionMode %main LocalSize 1 1 1\n"
+  "\n"
+  "TypeInt %u32T 32 0\n"
+  "TypeVector %v3uT %u32T 3\n"
+  "TypePointer %v3u Input %v3uT\n"
+  "Variable %v3u %GlobalInvocationId Input\n"
+  "Decorate %GlobalInvocationId BuiltIn GlobalInvocationId\n"
+  "TypeVoid %voidT\n"
+  "TypeFunction %fn_voidT %voidT\n"
+  "TypeFloat %f32T 32\n"
+  "TypeVector %v3fT %f32T 3\n"
+  "TypePointer %v3f Function %v3fT\n"
+  "TypeStruct %lightInfoST %v3fT %v3fT %f32T\n"
+  "TypePointer %lightInfoS Function %lightInfoST\n"
+  "TypeFunction %fn_compLightT %v3fT %v3f %lightInfoS\n"
+  "TypeInt %i32T 32 1\n"
+  "Constant %i32T %%0 0\n"
+  "Constant %i32T %%1 1\n"
+  "Constant %i32T %%2 2\n"
+  "Constant %f32T %half 0.5\n"
+  "TypePointer %f32 Function %f32T\n"
+  "\n"
+  "Function %voidT %main None %fn_voidT\n"
+  "  Label %%entry\n"
+  "  Return\n"
+  "FunctionEnd\n"
+  "\n"
+  "Function %v3fT %computeLight None %fn_compLightT\n"
+  "FunctionParameter %v3f %position\n"
+  "FunctionParameter %lightInfoS %lightInfo\n"
+  "  Label %%label1\n"
+  "  Variable %v3f %direction Function\n"
+  "  AccessChain %v3f %%accessDirection %lightInfo %%1\n"
+  "  Load %v3fT %%directionS %%accessDirection\n"
+  "  Load %v3fT %%position %position\n"
+  "  FSub %v3fT %%fsub %%directionS %%position\n"
+  "  ExtInst %v3fT %%normalizeResult %glsl Normalize %%fsub\n"
+  "  Store %direction %%normalizeResult\n"
+  "  AccessChain %f32 %%accessIntensity %lightInfo %%2\n"
+  "  Load %f32T %%intensity %%accessIntensity\n"
+  "  VectorTimesScalar %v3fT %%dirIntensity %%normalizeResult %%intensity\n"
+  "  ReturnValue %%dirIntensity\n"
+  "FunctionEnd\n";
+
+static sa_bool sameDiagnostics(sa_diagnostics_t* pA, sa_diagnostics_t* pB) {
+  if(pA->errorCount != pB->errorCount || pA->warningCount != pB->warningCount || pA->recordCount != pB->recordCount)
+    return SA_FALSE;
+
+  for(sa_uint32_t i = 0; i < pA->recordCount; i++) {
+    const sa_diagnostic_t* pLeft = &pA->pRecords[i];
+    const sa_diagnostic_t* pRight = &pB->pRecords[i];
+
+    if(pLeft->code != pRight->code || pLeft->line != pRight->line || pLeft->column != pRight->column || pLeft->spanLength != pRight->spanLength)
+      return SA_FALSE;
+
+    // Every call overwrites text of its own diagnostics only
+    if(strcmp(sa_diagnosticMessage(pA, i), sa_diagnosticMessage(pB, i)) != 0)
+      return SA_FALSE;
+  }
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Assembles text with sa_assembleToBinary and with sa_assembleSPIRVN followed by sa_bakeSPIRV
+ *
+ * @param text
+ * @param length
+ * @return sa_bool both give the same bytes and the same diagnostics
+ */
+static sa_bool sameAsBaked(const char* text, sa_uint32_t length) {
+  sa_context_t ctx;
+  sa_context_t bakeCtx;
+  sa_context_t directCtx;
+  sa_initContext(&ctx);
+  sa_initContext(&bakeCtx);
+  sa_initContext(&directCtx);
+
+  // Baking clears diagnostics, so it gets a context of its own
+  sa_assembly_t spirvAsm = {0};
+  sa_assembleSPIRVN(&ctx, text, length, &spirvAsm);
+
+  sa_uint32_t bakedSize = 0;
+  sa_uint8_t* pBaked = sa_bakeSPIRV(&bakeCtx, &spirvAsm, &bakedSize);
+
+  sa_uint32_t directSize = 0;
+  sa_uint8_t* pDirect = sa_assembleToBinary(&directCtx, text, length, &directSize);
+
+  const sa_bool same = (pBaked == SA_NULL) == (pDirect == SA_NULL) && bakedSize == directSize &&
+    (!pBaked || memcmp(pBaked, pDirect, bakedSize) == 0) && sameDiagnostics(&ctx.diagnostics, &directCtx.diagnostics);
+
+  sa_freeSPIRV(pBaked);
+  sa_freeSPIRV(pDirect);
+  sa_freeAssembly(&spirvAsm);
+  sa_freeContext(&ctx);
+  sa_freeContext(&bakeCtx);
+  sa_freeContext(&directCtx);
+
+  return same;
+}
+
+static void checkDirectBinary(sa_uint32_t scale) {
+  puts("direct binary:");
+
+  const sa_uint32_t shaderLength = (sa_uint32_t)strlen(SPA_SHADER);
+  text_t text = {0};
+
+  check(sameAsBaked("", 0), "empty text differs from baked");
+  check(sameAsBaked(SPA_SHADER, shaderLength), "shader differs from baked");
+  check(sameAsBaked(SPA_SHADER, shaderLength - 1), "shader without last new line differs from baked");
+
+  // Failed lines are dropped in both, errors have to come out in the same order
+  appendText(&text, "%sNotAnInstruction %%x\nConstant %%u32T %%big 0x100000000\nIAdd %%u32T %%s %%x %%x %%x %%x\nEntryPoint Nowhere %%main \"bad\"\n", SPA_SHADER);
+  check(sameAsBaked(text.pData, text.size), "shader with errors differs from baked");
+
+  text.size = 0;
+  makeModule(&text, 1000 * scale, SA_TRUE);
+  check(sameAsBaked(text.pData, text.size), "generated module differs from baked");
+
+  // Every prefix of shader, then shader with random bytes overwritten
+  sa_uint32_t differing = 0;
+  sa_uint32_t cases = 0;
+
+  for(sa_uint32_t cut = 0; cut <= shaderLength; cut++, cases++)
+    differing += !sameAsBaked(SPA_SHADER, cut);
+
+  static const char MUTATIONS[] = " \n%;\"#0123456789.-xaZ";
+
+  for(sa_uint32_t i = 0; i < 2000 * scale; i++, cases++) {
+    text.size = 0;
+    appendText(&text, "%s", SPA_SHADER);
+
+    for(sa_uint32_t j = nextRandom() % 4; j < 4; j++)
+      text.pData[nextRandom() % shaderLength] = MUTATIONS[nextRandom() % (sizeof(MUTATIONS) - 1)];
+
+    differing += !sameAsBaked(text.pData, text.size);
+  }
+
+  printf("  %u cut and mutated shaders, %u differ\n", cases, differing);
+  check(differing == 0, "cut or mutated shader differs from baked");
+
+  // Time of both ways on module with over 1M words
+  text.size = 0;
+  makeModule(&text, 25000 * scale, SA_FALSE);
+
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  double bestBaked = 1e9;
+  double bestDirect = 1e9;
+
+  for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+    sa_assembly_t spirvAsm = {0};
+    sa_uint32_t binarySize = 0;
+
+    double start = seconds();
+    sa_assembleSPIRVN(&ctx, text.pData, text.size, &spirvAsm);
+    sa_uint8_t* pBaked = sa_bakeSPIRV(&ctx, &spirvAsm, &binarySize);
+    double time = seconds() - start;
+
+    if(time < bestBaked)
+      bestBaked = time;
+
+    sa_freeSPIRV(pBaked);
+    sa_freeAssembly(&spirvAsm);
+
+    start = seconds();
+    sa_uint8_t* pDirect = sa_assembleToBinary(&ctx, text.pData, text.size, &binarySize);
+    time = seconds() - start;
+
+    if(time < bestDirect)
+      bestDirect = time;
+
+    sa_freeSPIRV(pDirect);
+  }
+
+  printf("  %.1f MB: assemble and bake %.2f ms, straight to binary %.2f ms\n", text.size / 1e6, bestBaked * 1e3, bestDirect * 1e3);
+  check(sameAsBaked(text.pData, text.size), "big generated module differs from baked");
+
+  sa_freeContext(&ctx);
+  freeText(&text);
+}
+
+//
+// Parallel assembly, every thread count has to give the same binary and errors as sa_assembleSPIRVN
+//
+
+#define PARALLEL_MAX_THREADS 8
+
+static sa_uint8_t* bakeAssembly(const sa_assembly_t* pAsm, sa_uint32_t* pSizeOut) {
+  // Baking clears diagnostics, so assembling errors are kept in context of caller
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  sa_uint8_t* pBinary = sa_bakeSPIRV(&ctx, (sa_assembly_t*)pAsm, pSizeOut);
+
+  sa_freeContext(&ctx);
+
+  return pBinary;
+}
+
+/**
+ * @brief Assembles text on 1 to PARALLEL_MAX_THREADS threads and checks every result against sa_assembleSPIRVN
+ *
+ * @param what name of case
+ * @param pText
+ * @param timed prints wall time of every thread count
+ */
+static void compareParallel(const char* what, const text_t* pText, sa_bool timed) {
+  sa_context_t serialCtx;
+  sa_initContext(&serialCtx);
+
+  sa_assembly_t serialAsm = {0};
+  double serial = 1e9;
+
+  for(sa_uint32_t run = 0; run < (timed ? BENCH_RUNS : 1); run++) {
+    sa_freeAssembly(&serialAsm);
+    sa__clearDiagnostics(&serialCtx.diagnostics);
+
+    double start = wallSeconds();
+    sa_assembleSPIRVN(&serialCtx, pText->pData, pText->size, &serialAsm);
+    double time = wallSeconds() - start;
+
+    if(time < serial)
+      serial = time;
+  }
+
+  if(timed)
+    printf("  %-24s serial:    %8.2f ms\n", what, serial * 1e3);
+
+  sa_uint32_t serialSize = 0;
+  sa_uint8_t* pSerial = bakeAssembly(&serialAsm, &serialSize);
+
+  double oneThread = 0.0;
+  sa_uint32_t differing = 0;
+
+  for(sa_uint32_t threads = 1; threads <= PARALLEL_MAX_THREADS; threads++) {
+    sa_context_t ctx;
+    sa_initContext(&ctx);
+
+    double best = 1e9;
+    sa_uint32_t binarySize = 0;
+    sa_uint8_t* pBinary = SA_NULL;
+
+    for(sa_uint32_t run = 0; run < (timed ? BENCH_RUNS : 1); run++) {
+      sa_assembly_t spirvAsm = {0};
+
+      double start = wallSeconds();
+      sa_assembleSPIRVParallel(&ctx, pText->pData, pText->size, &spirvAsm, threads);
+      double time = wallSeconds() - start;
+
+      if(time < best)
+        best = time;
+
+      sa_freeSPIRV(pBinary);
+      pBinary = bakeAssembly(&spirvAsm, &binarySize);
+      sa_freeAssembly(&spirvAsm);
+    }
+
+    if(threads == 1)
+      oneThread = best;
+
+    if(timed)
+      printf("  %-24s %u threads: %8.2f ms, %.2fx of 1 thread\n", what, threads, best * 1e3, oneThread / best);
+
+    if(binarySize != serialSize || memcmp(pBinary, pSerial, serialSize) != 0 || !sameDiagnostics(&ctx.diagnostics, &serialCtx.diagnostics)) {
+      printf("  %s on %u threads differs from serial assembly\n", what, threads);
+      differing++;
+    }
+
+    sa_freeSPIRV(pBinary);
+    sa_freeContext(&ctx);
+  }
+
+  check(differing == 0, what);
+
+  sa_freeSPIRV(pSerial);
+  sa_freeAssembly(&serialAsm);
+  sa_freeContext(&serialCtx);
+}
+
+static void benchParallel(sa_uint32_t scale) {
+#ifdef SA_ENABLE_THREADS
+  puts("parallel:");
+#else
+  puts("parallel (no SA_ENABLE_THREADS, chunks run one after another):");
+#endif
+
+  text_t text = {0};
+
+  // More threads than functions, and no functions at all
+  makeModule(&text, 3, SA_FALSE);
+  compareParallel("3 functions", &text, SA_FALSE);
+
+  text.size = 0;
+  appendText(&text, "TypeInt %%u32 32 0\nConstant %%u32 %%one 1\n");
+  compareParallel("no functions", &text, SA_FALSE);
+
+  // Errors in many chunks have to keep lines and order of serial assembly
+  text.size = 0;
+  appendText(&text, "TypeVoid %%void\nTypeFunction %%fnT %%void\nTypeInt %%u32 32 0\n");
+
+  for(sa_uint32_t i = 0; i < 400; i++) {
+    appendText(&text, "Function %%void %%fn%u None %%fnT\n  Label %%l%u\n", i, i);
+
+    if(i % 37 == 0)
+      appendText(&text, "  NotAnInstruction %%x%u\n  Constant %%u32 %%big%u 0x100000000\n", i, i);
+
+    appendText(&text, "  IAdd %%u32 %%s%u %%s%u %%s%u\n  Return\nFunctionEnd\n", i, i, i);
+  }
+
+  compareParallel("functions with errors", &text, SA_FALSE);
+
+  text.size = 0;
+  makeModule(&text, 40000 * scale, SA_TRUE);
+  compareParallel("9.6 MB module", &text, SA_TRUE);
+
+  freeText(&text);
+}
+
+//
+// Batch assembly, every output has to hold the same bytes and errors as its input assembled alone
+//
+
+#define BATCH_INPUT_COUNT 24
+
+static void checkBatch(sa_uint32_t scale) {
+  puts("batch:");
+
+  text_t texts[BATCH_INPUT_COUNT];
+  sa_batchInput_t inputs[BATCH_INPUT_COUNT];
+  sa__setMemory(texts, 0, sizeof(texts));
+
+  const sa_uint32_t shaderLength = (sa_uint32_t)strlen(SPA_SHADER);
+
+  appendText(&texts[0], "%s", SPA_SHADER);
+  appendText(&texts[1], "%sNotAnInstruction %%x\nConstant %%u32T %%big 0x100000000\n", SPA_SHADER);
+  makeModule(&texts[2], 2000 * scale, SA_FALSE);
+  // texts[3] stays empty
+  appendText(&texts[4], "%.*s", (int)(shaderLength / 2), SPA_SHADER);
+  makeModule(&texts[5], 200 * scale, SA_TRUE);
+  appendText(&texts[6], "EntryPoint Nowhere %%main \"bad\"\nIAdd %%u32 %%s %%x %%x %%x %%x\n");
+
+  // Rest are shaders with random bytes overwritten, some of them fail
+  static const char MUTATIONS[] = " \n%;\"#0123456789.-xaZ";
+
+  for(sa_uint32_t i = 7; i < BATCH_INPUT_COUNT; i++) {
+    appendText(&texts[i], "%s", SPA_SHADER);
+
+    for(sa_uint32_t j = nextRandom() % 4; j < 4; j++)
+      texts[i].pData[nextRandom() % shaderLength] = MUTATIONS[nextRandom() % (sizeof(MUTATIONS) - 1)];
+  }
+
+  // Serial results, every input on its own context
+  sa_context_t serialCtx[BATCH_INPUT_COUNT];
+  sa_uint8_t* pSerial[BATCH_INPUT_COUNT];
+  sa_uint32_t serialSize[BATCH_INPUT_COUNT];
+  sa_bool anyFailed = SA_FALSE;
+
+  for(sa_uint32_t i = 0; i < BATCH_INPUT_COUNT; i++) {
+    inputs[i].pText = texts[i].pData;
+    inputs[i].length = texts[i].size;
+
+    sa_initContext(&serialCtx[i]);
+    pSerial[i] = sa_assembleToBinary(&serialCtx[i], texts[i].pData, texts[i].size, &serialSize[i]);
+
+    if(serialCtx[i].diagnostics.errorCount > 0)
+      anyFailed = SA_TRUE;
+  }
+
+  check(anyFailed, "batch has no failing input");
+
+  static const sa_uint32_t WORKER_COUNTS[] = { 1, 3, 8 };
+
+  for(sa_uint32_t w = 0; w < sizeof(WORKER_COUNTS) / sizeof(WORKER_COUNTS[0]); w++) {
+    sa_context_t ctx;
+    sa_initContext(&ctx);
+
+    sa_batchOutput_t outputs[BATCH_INPUT_COUNT];
+
+    double start = wallSeconds();
+    const sa_bool ok = sa_assembleBatch(&ctx, inputs, BATCH_INPUT_COUNT, outputs, WORKER_COUNTS[w]);
+    double time = wallSeconds() - start;
+
+    sa_uint32_t differing = 0;
+
+    for(sa_uint32_t i = 0; i < BATCH_INPUT_COUNT; i++) {
+      const sa_batchOutput_t* pOutput = &outputs[i];
+      const sa_bool sameBytes = (pOutput->pBinary == SA_NULL) == (pSerial[i] == SA_NULL) && pOutput->binarySize == serialSize[i] &&
+        (!pSerial[i] || memcmp(pOutput->pBinary, pSerial[i], serialSize[i]) == 0);
+
+      if(!sameBytes || !sameDiagnostics(&outputs[i].errors, &serialCtx[i].diagnostics)) {
+        printf("  input %u on %u workers differs from serial result\n", i, WORKER_COUNTS[w]);
+        differing++;
+      }
+    }
+
+    printf("  %u inputs on %u workers: %.2f ms, %u differ\n", BATCH_INPUT_COUNT, WORKER_COUNTS[w], time * 1e3, differing);
+    check(differing == 0, "batch output differs from serial result");
+    check(ok == !anyFailed && ctx.diagnostics.errorCount == 0, "batch result does not match failing inputs");
+
+    sa_freeBatchOutputs(outputs, BATCH_INPUT_COUNT);
+    sa_freeContext(&ctx);
+  }
+
+  for(sa_uint32_t i = 0; i < BATCH_INPUT_COUNT; i++) {
+    sa_freeSPIRV(pSerial[i]);
+    sa_freeContext(&serialCtx[i]);
+    freeText(&texts[i]);
+  }
+}
+
+//
+// Session, every edit has to leave assembly the same as whole text assembled again
+//
+
+// Session together with plain copy of its text, edits are checked against the copy, so gap in session text stays where edits leave it
+typedef struct checkedSession_s {
+  sa_session_t session;
+  text_t text;
+} checkedSession_t;
+
+/**
+ * @brief Finds text inside copy of session text
+ *
+ * @param pChecked
+ * @param needle
+ * @return sa_uint32_t offset of first match, SA_UINT32_MAX when there is none
+ */
+static sa_uint32_t findInSession(const checkedSession_t* pChecked, const char* needle) {
+  const char* match = strstr(pChecked->text.pData, needle);
+
+  return match ? (sa_uint32_t)(match - pChecked->text.pData) : SA_UINT32_MAX;
+}
+
+/**
+ * @brief Replaces range of text, text stays null terminated
+ *
+ * @param pText
+ * @param start
+ * @param end
+ * @param newText
+ */
+static void replaceText(text_t* pText, sa_uint32_t start, sa_uint32_t end, const char* newText) {
+  const sa_uint32_t length = (sa_uint32_t)strlen(newText);
+  const sa_uint32_t size = pText->size - (end - start) + length;
+
+  if(size >= pText->capacity) {
+    pText->capacity = size * 2 + 4096;
+    pText->pData = (char*)realloc(pText->pData, pText->capacity);
+  }
+
+  memmove(&pText->pData[start + length], &pText->pData[end], pText->size - end + 1);
+  memcpy(&pText->pData[start], newText, length);
+  pText->size = size;
+}
+
+/**
+ * @brief Checks that text given by sa_sessionText is the same as copy of it, gap of session text moves to its end
+ *
+ * @param pChecked
+ * @return sa_bool
+ */
+static sa_bool sameSessionText(checkedSession_t* pChecked) {
+  return pChecked->session.length == pChecked->text.size && memcmp(sa_sessionText(&pChecked->session), pChecked->text.pData, pChecked->text.size + 1) == 0;
+}
+
+/**
+ * @brief Edits session and compares its assembly and errors with whole text assembled again
+ *
+ * @param pChecked
+ * @param start
+ * @param end
+ * @param text
+ * @param pPatched counts edits that were patched in place, can be SA_NULL
+ * @return sa_bool session matches whole text assembled again
+ */
+static sa_bool editSession(checkedSession_t* pChecked, sa_uint32_t start, sa_uint32_t end, const char* text, sa_uint32_t* pPatched) {
+  sa_session_t* pSession = &pChecked->session;
+  const sa_bool patched = sa_sessionEdit(pSession, start, end, text, (sa_uint32_t)strlen(text));
+
+  if(pPatched)
+    *pPatched += patched;
+
+  replaceText(&pChecked->text, start, end, text);
+
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  sa_assembly_t spirvAsm = {0};
+  sa_assembleSPIRVN(&ctx, pChecked->text.pData, pChecked->text.size, &spirvAsm);
+
+  sa_uint32_t wholeSize = 0;
+  sa_uint32_t sessionSize = 0;
+  sa_uint8_t* pWhole = bakeAssembly(&spirvAsm, &wholeSize);
+  sa_uint8_t* pSessionBinary = bakeAssembly(&pSession->assembly, &sessionSize);
+
+  const sa_bool same = pSession->length == pChecked->text.size && wholeSize == sessionSize && memcmp(pWhole, pSessionBinary, wholeSize) == 0 && sameDiagnostics(&ctx.diagnostics, &pSession->assembler.pCtx->diagnostics);
+
+  sa_freeSPIRV(pWhole);
+  sa_freeSPIRV(pSessionBinary);
+  sa_freeAssembly(&spirvAsm);
+  sa_freeContext(&ctx);
+
+  return same;
+}
+
+/**
+ * @brief Replaces first match of old text in session and checks result
+ *
+ * @param pChecked
+ * @param oldText
+ * @param newText
+ * @param pPatched
+ */
+static void replaceInSession(checkedSession_t* pChecked, const char* oldText, const char* newText, sa_uint32_t* pPatched) {
+  const sa_uint32_t start = findInSession(pChecked, oldText);
+
+  if(start == SA_UINT32_MAX) {
+    printf("  FAIL: \"%s\" is not in session text\n", oldText);
+    failures++;
+
+    return;
+  }
+
+  if(!editSession(pChecked, start, start + (sa_uint32_t)strlen(oldText), newText, pPatched)) {
+    printf("  FAIL: replacing \"%s\" with \"%s\" differs from whole text assembled again\n", oldText, newText);
+    failures++;
+  }
+}
+
+static void checkSession(sa_uint32_t scale) {
+  puts("session:");
+
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  checkedSession_t checked = {0};
+  sa_uint32_t patched = 0;
+
+  appendText(&checked.text, "%s", SPA_SHADER);
+  sa_sessionBegin(&ctx, &checked.session, checked.text.pData, checked.text.size);
+
+  // EntryPoint lines are two instructions, the string, execution model, adding and removing whole line
+  replaceInSession(&checked, "\"main\"", "\"mainx\"", &patched);
+  replaceInSession(&checked, "GLCompute", "Vertex", &patched);
+  replaceInSession(&checked, "ExecutionMode", "EntryPoint Fragment %main \"frag\"\nExecutionMode", &patched);
+  replaceInSession(&checked, "EntryPoint Fragment %main \"frag\"\n", "", &patched);
+  // Lines of one instruction, same size and other size, inside and outside of function
+  replaceInSession(&checked, "LocalSize 1 1 1", "LocalSize 8 1 1", &patched);
+  replaceInSession(&checked, "%half 0.5", "%half 0.25", &patched);
+  replaceInSession(&checked, "  Store %direction %%normalizeResult\n", "", &patched);
+  replaceInSession(&checked, "  ReturnValue", "  Store %direction %%normalizeResult\n  ReturnValue", &patched);
+  replaceInSession(&checked, "; Light shader\n", "; Light shader\n; with one more comment\n", &patched);
+  replaceInSession(&checked, "Constant %i32T %%2 2\n", "Constant %i32T %%2 2\nConstant %i32T %%3 3\n", &patched);
+  // Function line, then text that does not assemble and back
+  replaceInSession(&checked, "%computeLight None", "%computeLight Inline", &patched);
+  replaceInSession(&checked, "Load %f32T", "Lod %f32T", &patched);
+  replaceInSession(&checked, "Lod %f32T", "Load %f32T", &patched);
+
+  printf("  %u of 13 edits patched in place\n", patched);
+  check(patched > 0, "no edit of shader was patched in place");
+  check(sameSessionText(&checked), "session text differs from its copy after edits of shader");
+
+  // Random edits, every 20th one puts whole shader back so most of them start from text without errors
+  static const char* LINES[] = {
+    "; note\n", "\n", "Decorate %GlobalInvocationId BuiltIn GlobalInvocationId\n", "  Store %direction %%normalizeResult\n",
+    "ExecutionMode %main LocalSize 2 2 1\n", "  Load %v3fT %%again %%accessDirection\n", "EntryPoint Vertex %main \"v\"\n",
+    "Constant %i32T %%3 3\n", "FunctionEnd\n",
+  };
+  static const char* PIECES[] = { "", " ", "1", "%%0", "x", "\n" };
+
+  const sa_uint32_t editCount = 1000 * scale;
+  sa_uint32_t differing = 0;
+
+  patched = 0;
+
+  for(sa_uint32_t i = 0; i < editCount; i++) {
+    const sa_uint32_t kind = nextRandom() % 4;
+    const char* snippet = kind < 2 ? LINES[nextRandom() % (sizeof(LINES) / sizeof(LINES[0]))] : kind == 2 ? "" : PIECES[nextRandom() % (sizeof(PIECES) / sizeof(PIECES[0]))];
+    const char* pText = checked.text.pData;
+    const sa_uint32_t length = checked.text.size;
+    sa_uint32_t start = nextRandom() % (length + 1);
+    sa_uint32_t end = start + nextRandom() % 16;
+
+    if(i % 20 == 0) {
+      start = 0;
+      end = length;
+      snippet = SPA_SHADER;
+    }
+    else if(kind < 3) {
+      // Line is inserted, replaced or removed, the way editors usually change text
+      while(start > 0 && pText[start - 1] != '\n')
+        start--;
+
+      end = start;
+
+      while(kind > 0 && end < length && pText[end] != '\n')
+        end++;
+
+      end += kind > 0 && end < length;
+    }
+
+    if(end > length)
+      end = length;
+
+    differing += !editSession(&checked, start, end, snippet, &patched);
+  }
+
+  printf("  %u random edits, %u patched in place, %u differ\n", editCount, patched, differing);
+  check(differing == 0, "random session edit differs from whole text assembled again");
+  check(sameSessionText(&checked), "session text differs from its copy after random edits");
+
+  sa_sessionEnd(&checked.session);
+  freeText(&checked.text);
+
+  // Time of edits in the middle of big module, compared with assembling it whole
+  makeModule(&checked.text, 25000 * scale, SA_FALSE);
+
+  sa_assembly_t spirvAsm = {0};
+  double start = seconds();
+  sa_assembleSPIRVN(&ctx, checked.text.pData, checked.text.size, &spirvAsm);
+  const double whole = seconds() - start;
+
+  sa_freeAssembly(&spirvAsm);
+  sa_sessionBegin(&ctx, &checked.session, checked.text.pData, checked.text.size);
+
+  // Constant of the function in the middle
+  char id[32];
+  snprintf(id, sizeof(id), "%%k%u ", 12500 * scale);
+
+  const sa_uint32_t valueStart = findInSession(&checked, id) + (sa_uint32_t)strlen(id);
+  sa_uint32_t constantLine = valueStart;
+
+  while(checked.text.pData[constantLine - 1] != '\n')
+    constantLine--;
+
+  // Even count of edits puts first digit of value back, so copy of text stays right
+  const char digits[2] = { '9', checked.text.pData[valueStart] };
+  const sa_uint32_t repeats = 200;
+
+  // First edit moves gaps of session from the end of text to the constant, later ones only move them between nearby lines
+  patched = sa_sessionEdit(&checked.session, valueStart, valueStart + 1, &digits[1], 1);
+  start = seconds();
+
+  // First digit of value changes, so nothing after it moves
+  for(sa_uint32_t i = 0; i < repeats; i++)
+    patched += sa_sessionEdit(&checked.session, valueStart, valueStart + 1, &digits[i % 2], 1);
+
+  const double sameSize = (seconds() - start) / repeats;
+
+  // Line before the constant one is inserted and removed again, lines after it only move when they are between this edit and the one before
+  start = seconds();
+
+  for(sa_uint32_t i = 0; i < repeats; i++) {
+    patched += sa_sessionEdit(&checked.session, constantLine, constantLine, "Return\n", 7);
+    patched += sa_sessionEdit(&checked.session, constantLine, constantLine + 7, "", 0);
+  }
+
+  const double insertDelete = (seconds() - start) / (repeats * 2);
+
+  // Line inserted and removed in the first and the last function one after another, gap goes through whole text every time
+  const sa_uint32_t farRepeats = 20;
+  const sa_uint32_t firstReturn = findInSession(&checked, "Return\n");
+  const sa_uint32_t lastReturn = checked.text.size - (sa_uint32_t)strlen("Return\nFunctionEnd\n");
+
+  start = seconds();
+
+  for(sa_uint32_t i = 0; i < farRepeats; i++) {
+    const sa_uint32_t offset = i % 2 ? lastReturn : firstReturn;
+
+    patched += sa_sessionEdit(&checked.session, offset, offset, "Return\n", 7);
+    patched += sa_sessionEdit(&checked.session, offset, offset + 7, "", 0);
+  }
+
+  const double farInsertDelete = (seconds() - start) / (farRepeats * 2);
+
+  printf("  %u lines: whole text %.2f ms, same size edit %.2f us, line insert or delete %.2f us (%.2f us far from the one before)\n", checked.session.lineCount, whole * 1e3, sameSize * 1e6, insertDelete * 1e6, farInsertDelete * 1e6);
+  check(patched == 1 + repeats * 3 + farRepeats * 2, "edits in big module were not patched in place");
+  check(editSession(&checked, 0, 0, "", SA_NULL), "big module session differs from whole text assembled again");
+  check(sameSessionText(&checked), "big module session text differs from its copy");
+
+  sa_sessionEnd(&checked.session);
+  sa_freeContext(&ctx);
+  freeText(&checked.text);
+}
+
+//
+// Scanning, both front ends on text with comments and indentation
+//
+
+static const char* SBA_BLOCK =
+  "# Types\n"
+  "void %void;\n"
+  "int %i32 32;\n"
+  "float %f32 32;\n"
+  "vector %v4f %f32 4;\n"
+  "struct %someStruct {\n"
+  "  %v4f %member1;\n"
+  "  %f32 %member2;\n"
+  "};\n"
+  "decorate %inPos Location 0;\n"
+  "fn %main %void()\n"
+  "  %outCol = %inPos;\n"
+  "  @glsl.Normalize(%inPos);\n"
+  "  ret;\n"
+  "endfn\n\n";
+
+static void benchScan(sa_uint32_t scale) {
+  puts("scan:");
+
+  text_t text = {0};
+  makeModule(&text, 40000 * scale, SA_TRUE);
+
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  double best = 1e9;
+
+  for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+    sa_assembly_t spirvAsm = {0};
+
+    double start = seconds();
+    sa_assembleSPIRVN(&ctx, text.pData, text.size, &spirvAsm);
+    double time = seconds() - start;
+
+    if(time < best)
+      best = time;
+
+    sa_freeAssembly(&spirvAsm);
+  }
+
+  printf("  .spa %.1f MB: %.0f MB/s\n", text.size / 1e6, text.size / 1e6 / best);
+  check(ctx.diagnostics.errorCount == 0, "generated module with comments has errors");
+
+  // Same few ids on every line, so time goes to splitting text and not to id table
+  text.size = 0;
+  appendText(&text, "TypeInt %%u32 32 0\nTypeFunction %%fnT %%u32\nFunction %%u32 %%main None %%fnT\n  Label %%%%entry\n");
+
+  for(sa_uint32_t i = 0; i < 100000 * scale; i++)
+    appendText(&text, "  ; Sum of loaded value and product\n  IAdd %%u32 %%%%sum %%%%a %%%%b\n  Load %%u32 %%%%loaded %%%%pointerToSomething\n        IMul %%u32 %%%%product    %%%%sum    %%%%loaded\n\n");
+
+  appendText(&text, "FunctionEnd\n");
+  best = 1e9;
+
+  for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+    sa_assembly_t spirvAsm = {0};
+
+    double start = seconds();
+    sa_assembleSPIRVN(&ctx, text.pData, text.size, &spirvAsm);
+    double time = seconds() - start;
+
+    if(time < best)
+      best = time;
+
+    sa_freeAssembly(&spirvAsm);
+  }
+
+  printf("  .spa %.1f MB, few ids: %.0f MB/s\n", text.size / 1e6, text.size / 1e6 / best);
+  check(ctx.diagnostics.errorCount == 0, "generated function with few ids has errors");
+
+  text.size = 0;
+
+  for(sa_uint32_t i = 0; i < 20000 * scale; i++)
+    appendText(&text, "%s", SBA_BLOCK);
+
+  best = 1e9;
+  sa_uint32_t tokenCount = 0;
+
+  for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+    sa_lexer_t lexer;
+
+    double start = seconds();
+    sa_lexSPIRVN(text.pData, text.size, &lexer);
+    double time = seconds() - start;
+
+    if(time < best)
+      best = time;
+
+    tokenCount = lexer.tokenCount;
+    sa_freeLexer(&lexer);
+  }
+
+  printf("  .sba %.1f MB: %.0f MB/s, %u tokens\n", text.size / 1e6, text.size / 1e6 / best, tokenCount);
+  check(tokenCount % (20000 * scale) == 0, "every .sba block has to give the same tokens");
+
+  sa_freeContext(&ctx);
+  freeText(&text);
+}
+
+//
+// Literals
+//
+
+typedef struct literalCase_s {
+  const char* line;
+  sa_uint32_t wordCount;
+  sa_uint32_t words[2];
+} literalCase_t;
+
+static const literalCase_t LITERAL_CASES[] = {
+  { "Constant %u32 %c 0xDEADBEEF",           1, { 0xDEADBEEF } },
+  { "Constant %i32 %c -5",                   1, { 0xFFFFFFFB } },
+  { "Constant %i64 %c -2",                   2, { 0xFFFFFFFE, 0xFFFFFFFF } },
+  { "Constant %u64 %c 0x123456789ABCDEF0",   2, { 0x9ABCDEF0, 0x12345678 } },
+  { "Constant %u64 %c 18446744073709551615", 2, { 0xFFFFFFFF, 0xFFFFFFFF } },
+  { "Constant %f32 %c 1.5",                  1, { 0x3FC00000 } },
+  { "Constant %f32 %c 0.1",                  1, { 0x3DCCCCCD } },
+  { "Constant %f32 %c -2.5e-3",              1, { 0xBB23D70A } },
+  { "Constant %f32 %c 3",                    1, { 0x40400000 } },
+  { "Constant %f64 %c 0.1",                  2, { 0x9999999A, 0x3FB99999 } },
+  { "Constant %f64 %c 1e300",                2, { 0x8800759C, 0x7E37E43C } },
+  // Word count 0 means literal has to be rejected
+  { "Constant %u32 %c -1",                   0, { 0 } },
+  { "Constant %u32 %c 0x100000000",          0, { 0 } },
+  { "Constant %u64 %c 18446744073709551616", 0, { 0 } },
+};
+
+#define LITERAL_TYPES "TypeInt %u32 32 0\nTypeInt %i32 32 1\nTypeInt %u64 64 0\nTypeInt %i64 64 1\nTypeFloat %f32 32\nTypeFloat %f64 64\n"
+
+/**
+ * @brief Finds next Constant in assembly, starting after instruction *pIndex
+ *
+ * @param pAsm
+ * @param pIndex instruction index in types section, updated to found Constant
+ * @param pWordCountOut amount of value words
+ * @return const sa_uint32_t* value words, SA_NULL when there are no more constants
+ */
+static const sa_uint32_t* nextConstant(const sa_assembly_t* pAsm, sa_uint32_t* pIndex, sa_uint32_t* pWordCountOut) {
+  const sa__assemblySection_t* pSection = &pAsm->section[saSectionType_Types];
+
+  while(++*pIndex < pSection->instCount) {
+    const sa_uint32_t* pInst = &pSection->pWords[pSection->pInstOffsets[*pIndex]];
+
+    if((pInst[0] & 0xFFFF) == saOp_Constant) {
+      *pWordCountOut = (pInst[0] >> 16) - 3;
+
+      return pInst + 3;
+    }
+  }
+
+  return SA_NULL;
+}
+
+static void checkLiterals(sa_uint32_t scale) {
+  puts("literals:");
+
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  for(sa_uint32_t i = 0; i < sizeof(LITERAL_CASES) / sizeof(LITERAL_CASES[0]); i++) {
+    const literalCase_t* pCase = &LITERAL_CASES[i];
+    text_t text = {0};
+    appendText(&text, "%s%s\n", LITERAL_TYPES, pCase->line);
+
+    sa_assembly_t spirvAsm = {0};
+    sa_assembleSPIRVN(&ctx, text.pData, text.size, &spirvAsm);
+
+    sa_uint32_t index = SA_UINT32_MAX;
+    sa_uint32_t wordCount = 0;
+    const sa_uint32_t* pWords = nextConstant(&spirvAsm, &index, &wordCount);
+
+    if(pCase->wordCount == 0)
+      check(ctx.diagnostics.errorCount > 0 && ctx.diagnostics.pRecords[0].code == saDiagnostic_LiteralOutOfRange, pCase->line);
+    else
+      check(ctx.diagnostics.errorCount == 0 && pWords && wordCount == pCase->wordCount && memcmp(pWords, pCase->words, wordCount * sizeof(sa_uint32_t)) == 0, pCase->line);
+
+    sa_freeAssembly(&spirvAsm);
+    freeText(&text);
+  }
+
+  // Shortest text that round trips (%.9g and %.17g) has to give back the same bits
+  const sa_uint32_t count = 50000 * scale;
+  float* pFloats = (float*)malloc(count * sizeof(float));
+  double* pDoubles = (double*)malloc(count * sizeof(double));
+  text_t text = {0};
+
+  appendText(&text, "%s", LITERAL_TYPES);
+
+  for(sa_uint32_t i = 0; i < count; i++) {
+    sa_uint32_t floatBits;
+    sa_uint64_t doubleBits;
+
+    // Infinities and NaNs have no decimal text
+    do {
+      floatBits = nextRandom();
+    } while(((floatBits >> 23) & 0xFF) == 0xFF);
+
+    do {
+      doubleBits = ((sa_uint64_t)nextRandom() << 32) | nextRandom();
+    } while(((doubleBits >> 52) & 0x7FF) == 0x7FF);
+
+    memcpy(&pFloats[i], &floatBits, sizeof(float));
+    memcpy(&pDoubles[i], &doubleBits, sizeof(double));
+
+    appendText(&text, "Constant %%f32 %%f%u %.9g\nConstant %%f64 %%d%u %.17g\n", i, pFloats[i], i, pDoubles[i]);
+  }
+
+  double best = 1e9;
+  sa_assembly_t spirvAsm = {0};
+
+  for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+    sa_freeAssembly(&spirvAsm);
+    sa__clearDiagnostics(&ctx.diagnostics);
+
+    double start = seconds();
+    sa_assembleSPIRVN(&ctx, text.pData, text.size, &spirvAsm);
+    double time = seconds() - start;
+
+    if(time < best)
+      best = time;
+  }
+
+  sa_uint32_t mismatches = 0;
+  sa_uint32_t index = SA_UINT32_MAX;
+
+  for(sa_uint32_t i = 0; i < count; i++) {
+    sa_uint32_t floatWordCount = 0;
+    sa_uint32_t doubleWordCount = 0;
+    const sa_uint32_t* pFloat = nextConstant(&spirvAsm, &index, &floatWordCount);
+    const sa_uint32_t* pDouble = pFloat ? nextConstant(&spirvAsm, &index, &doubleWordCount) : SA_NULL;
+
+    if(!pDouble)
+      break;
+
+    if(floatWordCount != 1 || memcmp(pFloat, &pFloats[i], sizeof(float)) != 0) {
+      if(mismatches++ < 3)
+        printf("  round trip of %.9g differs\n", pFloats[i]);
+    }
+
+    if(doubleWordCount != 2 || memcmp(pDouble, &pDoubles[i], sizeof(double)) != 0) {
+      if(mismatches++ < 3)
+        printf("  round trip of %.17g differs\n", pDoubles[i]);
+    }
+  }
+
+  printf("  %u float and %u double constants, %.1f MB: %.0f MB/s, %u differ\n", count, count, text.size / 1e6, text.size / 1e6 / best, mismatches);
+  check(ctx.diagnostics.errorCount == 0, "round trip constants have errors");
+  check(mismatches == 0 && spirvAsm.section[saSectionType_Types].instCount == 6 + count * 2, "float round trip");
+
+  sa_freeAssembly(&spirvAsm);
+  sa_freeContext(&ctx);
+  freeText(&text);
+  free(pFloats);
+  free(pDoubles);
+}
+
+//
+// Decoder, malformed binaries have to be rejected with right code
+//
+
+/**
+ * @brief Disassembles binary into filled assembly and checks code of first diagnostic
+ *
+ * @param what name of case
+ * @param pValid binary that fills assembly first
+ * @param validWordCount
+ * @param pBinary binary that has to be rejected
+ * @param wordCount
+ * @param code expected code of first diagnostic
+ * @param headerRejected binary is rejected before anything is decoded, so assembly has to stay as it was
+ */
+static void expectRejected(const char* what, const sa_uint8_t* pValid, sa_uint32_t validWordCount, const sa_uint8_t* pBinary, sa_uint32_t wordCount, sa_uint16_t code, sa_bool headerRejected) {
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  sa_assembly_t spirvAsm = {0};
+  sa_disassembleSPIRV(&ctx, &spirvAsm, (sa_uint8_t*)pValid, validWordCount);
+
+  const sa_uint32_t bound = spirvAsm.header.bounds;
+  const sa_uint32_t insts = instructionCount(&spirvAsm);
+
+  if(!headerRejected) {
+    sa_freeAssembly(&spirvAsm);
+    sa__setMemory(&spirvAsm, 0, sizeof(spirvAsm));
+  }
+
+  sa_disassembleSPIRV(&ctx, &spirvAsm, (sa_uint8_t*)pBinary, wordCount);
+
+  printf("  %-26s %s\n", what, ctx.diagnostics.recordCount > 0 ? sa_diagnosticMessage(&ctx.diagnostics, 0) : "(accepted)");
+  check(ctx.diagnostics.errorCount > 0 && ctx.diagnostics.pRecords[0].code == code, what);
+
+  if(headerRejected)
+    check(spirvAsm.header.bounds == bound && instructionCount(&spirvAsm) == insts, "rejected binary changed assembly");
+
+  sa_freeAssembly(&spirvAsm);
+  sa_freeContext(&ctx);
+}
+
+static void checkDecoder(sa_uint32_t scale) {
+  puts("decoder:");
+
+  text_t text = {0};
+  makeModule(&text, 200, SA_FALSE);
+
+  sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  sa_uint32_t binarySize = 0;
+  sa_uint8_t* pValid = sa_assembleToBinary(&ctx, text.pData, text.size, &binarySize);
+  const sa_uint32_t wordCount = binarySize / 4;
+  sa_uint32_t* pWords = (sa_uint32_t*)malloc(binarySize + sizeof(sa_uint32_t));
+
+  freeText(&text);
+
+#define RESET_WORDS() memcpy(pWords, pValid, binarySize)
+
+  RESET_WORDS();
+  expectRejected("header cut to 4 words", pValid, wordCount, (sa_uint8_t*)pWords, 4, saDiagnostic_WrongHeader, SA_TRUE);
+
+  RESET_WORDS();
+  pWords[0] = SA_CONVERT(0x12345678);
+  expectRejected("wrong magic", pValid, wordCount, (sa_uint8_t*)pWords, wordCount, saDiagnostic_WrongMagic, SA_TRUE);
+
+  RESET_WORDS();
+  pWords[0] = SA_CONVERT(0x03022307);
+  expectRejected("other byte order", pValid, wordCount, (sa_uint8_t*)pWords, wordCount, saDiagnostic_WrongMagic, SA_TRUE);
+
+  RESET_WORDS();
+  pWords[1] = SA_CONVERT(0x00020000);
+  expectRejected("version 2.0", pValid, wordCount, (sa_uint8_t*)pWords, wordCount, saDiagnostic_WrongHeader, SA_TRUE);
+
+  RESET_WORDS();
+  pWords[3] = 0;
+  expectRejected("id bound 0", pValid, wordCount, (sa_uint8_t*)pWords, wordCount, saDiagnostic_WrongHeader, SA_TRUE);
+
+  RESET_WORDS();
+  pWords[4] = SA_CONVERT(1);
+  expectRejected("schema 1", pValid, wordCount, (sa_uint8_t*)pWords, wordCount, saDiagnostic_WrongHeader, SA_TRUE);
+
+  RESET_WORDS();
+  expectRejected("not aligned to 4 bytes", pValid, wordCount, (sa_uint8_t*)pWords + 1, wordCount - 1, saDiagnostic_InvalidArgument, SA_TRUE);
+
+  RESET_WORDS();
+  pWords[5] = SA_CONVERT(SA_CONVERT(pWords[5]) & 0xFFFF);
+  expectRejected("word count 0", pValid, wordCount, (sa_uint8_t*)pWords, wordCount, saDiagnostic_MalformedInstruction, SA_FALSE);
+
+  RESET_WORDS();
+  pWords[5] = SA_CONVERT(SA_CONVERT(pWords[5]) | 0xFFFF0000);
+  expectRejected("word count past end", pValid, wordCount, (sa_uint8_t*)pWords, wordCount, saDiagnostic_MalformedInstruction, SA_FALSE);
+
+  // Binary ends right after opcode word of last instruction with operands
+  sa_uint32_t lastStart = 5;
+
+  RESET_WORDS();
+
+  for(sa_uint32_t offset = 5; offset < wordCount; offset += SA_CONVERT(pWords[offset]) >> 16) {
+    if((SA_CONVERT(pWords[offset]) >> 16) > 1)
+      lastStart = offset;
+  }
+
+  expectRejected("cut inside instruction", pValid, wordCount, (sa_uint8_t*)pWords, lastStart + 1, saDiagnostic_MalformedInstruction, SA_FALSE);
+
+#ifndef SA_NO_FILE_IO
+  // File that ends in the middle of word
+  FILE* pFile = fopen("bench_truncated.spv", "wb");
+
+  if(pFile) {
+    fwrite(pValid, 1, binarySize - 2, pFile);
+    fclose(pFile);
+
+    sa_assembly_t spirvAsm = {0};
+
+    check(!sa_disassembleFile(&ctx, "bench_truncated.spv", &spirvAsm) && ctx.diagnostics.pRecords[0].code == saDiagnostic_File, "file cut inside word");
+    printf("  %-26s %s\n", "file cut inside word", sa_diagnosticMessage(&ctx.diagnostics, 0));
+
+    sa_freeAssembly(&spirvAsm);
+    remove("bench_truncated.spv");
+  }
+#endif
+
+  // Random words are changed, accepted binary has to bake back to the same size
+  const sa_uint32_t iterations = 20000 * scale;
+  sa_uint32_t accepted = 0;
+
+  for(sa_uint32_t i = 0; i < iterations; i++) {
+    RESET_WORDS();
+
+    const sa_uint32_t changes = 1 + nextRandom() % 4;
+
+    for(sa_uint32_t change = 0; change < changes; change++) {
+      const sa_uint32_t index = nextRandom() % wordCount;
+      const sa_uint32_t random = nextRandom();
+
+      // Mostly word counts, they are what decoder trusts
+      pWords[index] = random & 1 ? SA_CONVERT(((random >> 1) & 0xFFFF0000) | (SA_CONVERT(pWords[index]) & 0xFFFF)) : random;
+    }
+
+    const sa_uint32_t size = nextRandom() % 8 == 0 ? nextRandom() % (wordCount + 1) : wordCount;
+    sa_assembly_t spirvAsm = {0};
+
+    sa_disassembleSPIRV(&ctx, &spirvAsm, (sa_uint8_t*)pWords, size);
+
+    if(ctx.diagnostics.errorCount == 0) {
+      sa_uint32_t bakedSize = 0;
+      sa_uint8_t* pBaked = sa_bakeSPIRV(&ctx, &spirvAsm, &bakedSize);
+
+      accepted++;
+      check(bakedSize == size * 4, "accepted binary does not bake back to its size");
+      sa_freeSPIRV(pBaked);
+    }
+
+    sa_freeAssembly(&spirvAsm);
+  }
+
+  printf("  fuzz %u binaries, %u accepted\n", iterations, accepted);
+
+#undef RESET_WORDS
+
+  free(pWords);
+  sa_freeSPIRV(pValid);
+
+  // Throughput on big valid binary
+  makeModule(&text, 25000 * scale, SA_FALSE);
+  pValid = sa_assembleToBinary(&ctx, text.pData, text.size, &binarySize);
+  freeText(&text);
+
+  double best = 1e9;
+
+  for(sa_uint32_t run = 0; run < BENCH_RUNS; run++) {
+    sa_assembly_t spirvAsm = {0};
+
+    double start = seconds();
+    sa_disassembleSPIRV(&ctx, &spirvAsm, pValid, binarySize / 4);
+    double time = seconds() - start;
+
+    if(time < best)
+      best = time;
+
+    if(run == 0) {
+      sa_uint32_t bakedSize = 0;
+      sa_uint8_t* pBaked = sa_bakeSPIRV(&ctx, &spirvAsm, &bakedSize);
+
+      check(ctx.diagnostics.errorCount == 0 && bakedSize == binarySize && memcmp(pBaked, pValid, binarySize) == 0, "disassembled binary does not bake back to the same bytes");
+      sa_freeSPIRV(pBaked);
+    }
+
+    sa_freeAssembly(&spirvAsm);
+  }
+
+  printf("  %.1f MB binary: %.2f ms, %.0f MB/s\n", binarySize / 1e6, best * 1e3, binarySize / 1e6 / best);
+
+  sa_freeSPIRV(pValid);
+  sa_freeContext(&ctx);
+}
+
+int main(int argc, char** argv) {
+  const sa_uint32_t scale = argc > 1 && atoi(argv[1]) > 0 ? (sa_uint32_t)atoi(argv[1]) : 1;
+
+  check(sa_checkTables(SA_NULL), "tables");
+
+  benchIds(scale);
+  benchBake(scale);
+  checkDirectBinary(scale);
+  benchParallel(scale);
+  checkBatch(scale);
+  checkSession(scale);
+  benchScan(scale);
+  checkLiterals(scale);
+  checkDecoder(scale);
+
+  printf("%u checks failed\n", failures);
+
+  return failures == 0 ? 0 : 1;
+}
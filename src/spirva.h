@@ -45,6 +45,50 @@
 
 #include <stdlib.h>
 #include <stdarg.h>
+#include <float.h>
+
+// Text scanning uses SSE2 where compiler targets it and AVX2 when CPU supports it, define SA_NO_SIMD to use plain C
+#if !defined(SA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SA_SIMD_SSE2
+#include <emmintrin.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SA_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+// Define SA_ENABLE_THREADS to run chunks of sa_assembleSPIRVParallel and workers of sa_assembleBatch on threads, without it they run one after another
+#ifdef SA_ENABLE_THREADS
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+// sa_assembleFile and sa_disassembleFile map files where OS allows it, define SA_NO_FILE_IO to leave them out
+#ifndef SA_NO_FILE_IO
+#if defined(_WIN32)
+#define SA_FILE_IO_WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define SA_FILE_IO_POSIX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include <stdio.h>
+#endif
+#endif
 
 // XXX: Delete this; for debugging
 //#include <stdio.h>
@@ -73,12 +117,12 @@
 typedef char   sa_int8_t;
 typedef short  sa_int16_t;
 typedef int    sa_int32_t;
-typedef long   sa_int64_t;
+typedef long long sa_int64_t;
 
 typedef unsigned char  sa_uint8_t;
 typedef unsigned short sa_uint16_t;
 typedef unsigned int   sa_uint32_t;
-typedef unsigned long  sa_uint64_t;
+typedef unsigned long long sa_uint64_t;
 
 #define SA_TRUE   1
 #define SA_FALSE  0
@@ -96,6 +140,12 @@ typedef sa_int8_t     sa_bool;
 
 #define SA_MAX_ENUMERANT_ENTRIES 128
 
+// Size of a single arena chunk, bigger allocations get own chunk
+#define SA_ARENA_CHUNK_SIZE (64 * 1024)
+
+// Ids above that are not kept in flat id -> name index (binaries from outside can declare any bounds)
+#define SA_MAX_DENSE_SPIRV_ID 0x400000U
+
 // Used by OpEntryPoint
 enum sa__EntryPoint_e {
   saEntryPoint_Vertex = 0,
@@ -1317,16 +1367,71 @@ enum sa__AssemblySectionType_e {
   saSectionType_COUNT
 };
 
+typedef struct sa__stringPool_s {
+  // All strings null terminated, one after another; handle is offset of the string
+  char* pData;
+  sa_uint32_t size;
+  sa_uint32_t capacity;
+  // Open addressing hash, every slot holds handle + 1 (0 is empty slot)
+  sa_uint32_t* pSlots;
+  sa_uint32_t slotCount;
+  sa_uint32_t stringCount;
+} sa__stringPool_t;
+
 typedef struct sa__spirvId_s {
-  char textId[512];
+  // Handle to the name in sa__spirvIdTable_t::names
+  sa_uint32_t textId;
   sa_uint32_t binaryId;
+  // Set when id is result of TypeInt / TypeFloat, so Constant knows how to encode its literal
+  sa_uint8_t numericKind;
+  sa_uint8_t numericWidth;
+  sa_bool numericSigned;
 } sa__spirvId_t;
 
 typedef struct sa__spirvIdTable_s {
   sa__spirvId_t* pIds;
   sa_uint32_t idCount;
+  sa_uint32_t idCapacity;
+  sa__stringPool_t names;
+  // Open addressing hash of name handles, every slot holds index + 1 to pIds (0 is empty slot)
+  sa_uint32_t* pNameSlots;
+  sa_uint32_t nameSlotCount;
+  // Flat reverse index, binaryId -> index + 1 to pIds (0 means no such id), ids are dense up to bounds
+  sa_uint32_t* pIdSlots;
+  sa_uint32_t idSlotCount;
+  // Only set when table belongs to one chunk of parallel assembly
+  struct sa__parallelIds_s* pParallel;
+  // Only set while incremental session assembles edited lines
+  struct sa__idUseOrder_s* pUseOrder;
 } sa__spirvIdTable_t;
 
+// Checks that ids are used first in order of their numbers, starting from next
+typedef struct sa__idUseOrder_s {
+  sa_uint32_t next;
+  // Id above next was used before next
+  sa_bool broken;
+} sa__idUseOrder_t;
+
+// Word that holds id, section and offset inside its pWords
+typedef struct sa__idWordRef_s {
+  sa_uint32_t section;
+  sa_uint32_t offset;
+} sa__idWordRef_t;
+
+// What chunk of parallel assembly needs besides its own id table
+typedef struct sa__parallelIds_s {
+  // Every id word written by chunk, ids are chunk local until chunks are merged
+  sa__idWordRef_t* pIdWords;
+  sa_uint32_t idWordCount;
+  sa_uint32_t idWordCapacity;
+  // TypeInt / TypeFloat of whole text, binaryId of every entry holds text offset of declaration instead of id
+  const sa__spirvIdTable_t* pTypes;
+  // Index of next declaration with the same name in pTypes, SA_UINT32_MAX for last one
+  const sa_uint32_t* pNextTypes;
+  // Start of whole text, offsets in pTypes are relative to it
+  const char* pText;
+} sa__parallelIds_t;
+
 typedef struct sa__assemblyHeader_s {
     sa_uint32_t magic;
     sa_uint32_t version;
@@ -1335,6 +1440,7 @@ typedef struct sa__assemblyHeader_s {
     sa_uint32_t schema;
 } sa__assemblyHeader_t;
 
+// View of a single instruction, words point inside section word stream
 typedef struct sa__assemblyInstruction_s {
   sa_uint16_t opCode;
   sa_uint16_t wordSize;
@@ -1342,20 +1448,137 @@ typedef struct sa__assemblyInstruction_s {
 } sa__assemblyInstruction_t;
 
 typedef struct sa__assemblySection_s {
-  sa__assemblyInstruction_t* pInst;
+  // Instructions already in SPIR-V encoding, first word of each is (wordSize << 16) | opcode
+  sa_uint32_t* pWords;
+  sa_uint32_t wordCount;
+  sa_uint32_t wordCapacity;
+  // Offset of every instruction inside pWords
+  sa_uint32_t* pInstOffsets;
   sa_uint32_t instCount;
+  sa_uint32_t instCapacity;
 } sa__assemblySection_t;
 
+typedef struct sa__arenaChunk_s {
+  struct sa__arenaChunk_s* pNext;
+  sa_uint32_t size;
+  sa_uint32_t capacity;
+} sa__arenaChunk_t;
+
+#define sa__arenaChunkData(pChunk) (sa_ptr8(pChunk) + sizeof(sa__arenaChunk_t))
+
+typedef struct sa__arena_s {
+  sa__arenaChunk_t* pHead;
+  sa__arenaChunk_t* pCurrent;
+} sa__arena_t;
+
 typedef struct sa_assembly_s {
   sa__assemblyHeader_t header;
   sa__assemblySection_t section[saSectionType_COUNT];
+  // Owns all instructions and their words
+  sa__arena_t arena;
+  // Set by sa_assembleToBinary, words live on heap so they can become the binary and instruction offsets are not kept
+  sa_bool bakeOnly;
 } sa_assembly_t;
 
-struct sa__assemblerErrorMessages_s {
-  char** pMessages;
-  sa_uint32_t messagesAmount;
+// Read only cursor over binary owned by caller, nothing is copied
+typedef struct sa_spirvView_s {
+  sa__assemblyHeader_t header;
+  const sa_uint32_t* pWords;
+  sa_uint32_t wordCount;
+  // Word index of next instruction
+  sa_uint32_t offset;
+  // Set when instruction word count is zero or runs past end of binary
+  sa_bool malformed;
+} sa_spirvView_t;
+
+// Most arguments one diagnostic format can take
+#define SA_DIAGNOSTIC_ARG_COUNT 4
+
+enum sa__DiagnosticSeverity_e {
+  saSeverity_Error = 0,
+  saSeverity_Warning,
+};
+
+enum sa__DiagnosticCode_e {
+  // Tables or state of assembler are broken
+  saDiagnostic_Internal = 0,
+  // Entry point got missing or wrong argument
+  saDiagnostic_InvalidArgument,
+  saDiagnostic_UnknownMnemonic,
+  saDiagnostic_TooManyOperands,
+  saDiagnostic_LiteralOutOfRange,
+  saDiagnostic_WrongEnumerant,
+  saDiagnostic_TooManyWords,
+  saDiagnostic_WrongMagic,
+  // Version, id bound or schema of binary header is not valid
+  saDiagnostic_WrongHeader,
+  saDiagnostic_MalformedInstruction,
+  // File cannot be opened, read or has wrong size
+  saDiagnostic_File,
+  // SBA text does not follow the language
+  saDiagnostic_Syntax,
+  saDiagnostic_COUNT
 };
 
+// Argument of diagnostic, member in use follows from its format
+typedef union sa__diagnosticArg_u {
+  sa_int32_t number;
+  sa_uint32_t unsignedNumber;
+  float real;
+  // Offset from sa_diagnostic_t::strings, copy of string lives in sa_diagnostics_t::pStrings
+  sa_uint32_t stringOffset;
+} sa__diagnosticArg_t;
+
+// One reported problem, its text is made from format and arguments only when someone asks for it
+typedef struct sa_diagnostic_s {
+  // Has to be string literal, it is kept until text is made
+  const char* fmt;
+  sa_uint16_t code;
+  sa_uint8_t severity;
+  sa_uint8_t argCount;
+  // Line of text, 0 when diagnostic is not about text
+  sa_uint32_t line;
+  // Byte column inside line starting at 1 and length of what diagnostic points at, both 0 when unknown
+  sa_uint32_t column;
+  sa_uint32_t spanLength;
+  // Offset of first string argument copy
+  sa_uint32_t strings;
+  sa__diagnosticArg_t args[SA_DIAGNOSTIC_ARG_COUNT];
+} sa_diagnostic_t;
+
+struct sa_diagnostics_s;
+
+/**
+ * @brief Called with every recorded diagnostic right after it is reported
+ * 
+ * @param pUserData user pointer from sa_diagnostics_t
+ * @param pDiagnostics diagnostics holding the record, text can be made with sa_diagnosticMessage
+ * @param index index of the record
+ */
+typedef void (*sa_diagnosticSink_t)(void* pUserData, struct sa_diagnostics_s* pDiagnostics, sa_uint32_t index);
+
+// Diagnostics of one context, records are fixed size and text is never made while assembling
+typedef struct sa_diagnostics_s {
+  sa_diagnostic_t* pRecords;
+  sa_uint32_t recordCount;
+  sa_uint32_t recordCapacity;
+  // Every reported diagnostic, also the ones over limit that were not recorded
+  sa_uint32_t errorCount;
+  sa_uint32_t warningCount;
+  // Most records kept, 0 for no limit. Diagnostics over it are only counted
+  sa_uint32_t limit;
+  // Optional, set by user and kept when diagnostics are cleared
+  sa_diagnosticSink_t sink;
+  void* pSinkUserData;
+  // Null terminated copies of string arguments
+  char* pStrings;
+  sa_uint32_t stringsSize;
+  sa_uint32_t stringsCapacity;
+  // Text made by last sa_diagnosticMessage call
+  char* pMessage;
+  sa_uint32_t messageCapacity;
+} sa_diagnostics_t;
+
 struct sa__assemblerLowLevelOpCodeConnection_s {
   const char* opcodeMnemonic;
   const sa_uint32_t opcode;
@@ -1365,13 +1588,47 @@ struct sa__assemblerLowLevelOpCodeConnection_s {
   const sa_uint32_t possibleEnumerant[saAsmEnum_COUNT];
 };
 
+// Highest core opcode + 1, size of SA_ASSEMBLER_OPCODE_INFO
+#define SA_OPCODE_COUNT (saOp_PtrDiff + 1)
+
+// Everything known about opcode, indexed directly by opcode value. Holes have SA_NULL mnemonic
+struct sa__assemblerOpcodeInfo_s {
+  const char* mnemonic;
+  sa_uint8_t section;
+  sa_uint8_t minWordCount;
+  sa_bool variadic;
+  // Index into SA_ASSEMBLER_LOW_LEVEL_OPCODES
+  sa_uint16_t tableIndex;
+};
+
 struct sa__assemblerLowLevelEnumerantConnection_s {
   const char* enumerantMnemonic;
   sa_uint32_t enumerant;
 };
 
-static sa_uint32_t __gIdGeneratorHoldValue = 1;
-static struct sa__assemblerErrorMessages_s __gAssemblerErrorMessages = {0};
+// Everything assembler mutates besides assembly itself, one per thread
+typedef struct sa_context_s {
+  // Next id handed out by sa__genId
+  sa_uint32_t idGeneratorHoldValue;
+  sa_diagnostics_t diagnostics;
+} sa_context_t;
+
+// Used when SA_NULL is passed as context
+static sa_context_t __gDefaultContext = { 1, { SA_NULL } };
+
+// Incremental assembler, text is fed in chunks of any size and only unfinished last line is kept between them
+typedef struct sa_assembler_s {
+  sa_context_t* pCtx;
+  sa_assembly_t* pAssembly;
+  sa__spirvIdTable_t ids;
+  sa_bool insideFn;
+  // Line number of the first line that was not parsed yet
+  sa_uint32_t line;
+  // Unfinished line carried over from previous chunk
+  char* pPending;
+  sa_uint32_t pendingSize;
+  sa_uint32_t pendingCapacity;
+} sa_assembler_t;
 
 const struct sa__assemblerLowLevelOpCodeConnection_s SA_ASSEMBLER_LOW_LEVEL_OPCODES[] = {
   // semantic,                                  opcode,                                       argc, +var
@@ -1717,6 +1974,445 @@ const struct sa__assemblerLowLevelOpCodeConnection_s SA_ASSEMBLER_LOW_LEVEL_OPCO
   { "PtrDiff",                                  saOp_PtrDiff,                                   5, SA_FALSE, { SA_UINT32_MAX } }
 };
 
+// Indices into SA_ASSEMBLER_LOW_LEVEL_OPCODES ordered by mnemonic (byte order), used for binary search.
+// Regenerate when opcode table changes, sa_checkTables() reports when they drift apart
+const sa_uint16_t SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[] = {
+  58, 143, 142, 61, 220, 210, 211, 209, 288, 287, 214, 213, 212, 215, 207, 221,
+  218, 216, 208, 219, 217, 222, 191, 187, 188, 189, 190, 114, 185, 183, 184, 227,
+  228, 277, 15, 275, 255, 256, 72, 73, 74, 39, 40, 38, 42, 292, 41, 37,
+  205, 100, 99, 107, 101, 102, 110, 336, 56, 57, 75, 293, 272, 192, 198, 195,
+  193, 199, 196, 64, 301, 66, 137, 203, 201, 202, 204, 265, 264, 13, 14, 300,
+  11, 10, 9, 118, 105, 125, 130, 122, 116, 168, 174, 178, 172, 176, 170, 129,
+  120, 169, 175, 179, 173, 177, 171, 48, 51, 50, 49, 194, 200, 197, 112, 113,
+  62, 276, 267, 266, 269, 268, 294, 295, 259, 258, 238, 239, 236, 240, 262, 263,
+  67, 242, 246, 243, 241, 68, 303, 305, 304, 308, 311, 310, 312, 313, 328, 329,
+  330, 306, 307, 302, 319, 327, 324, 321, 318, 320, 309, 331, 332, 333, 334, 335,
+  325, 322, 314, 317, 316, 315, 326, 323, 260, 261, 248, 245, 247, 244, 237, 117,
+  138, 158, 121, 159, 119, 139, 91, 88, 86, 87, 92, 97, 96, 93, 98, 95,
+  94, 89, 81, 80, 79, 78, 85, 84, 83, 82, 284, 282, 283, 289, 281, 280,
+  279, 278, 285, 53, 90, 59, 63, 146, 145, 144, 147, 273, 257, 230, 226, 149,
+  234, 235, 8, 54, 155, 152, 156, 153, 154, 224, 135, 132, 134, 65, 6, 206,
+  12, 298, 299, 5, 297, 286, 0, 186, 150, 136, 223, 60, 111, 339, 337, 338,
+  106, 249, 271, 251, 253, 252, 254, 270, 231, 232, 104, 124, 161, 163, 165, 167,
+  128, 141, 115, 127, 77, 108, 109, 157, 225, 274, 182, 181, 180, 148, 290, 3,
+  2, 4, 45, 46, 44, 47, 43, 55, 7, 229, 76, 25, 17, 32, 31, 19,
+  36, 30, 22, 18, 21, 296, 28, 35, 291, 29, 34, 33, 26, 24, 23, 27,
+  20, 16, 103, 123, 160, 162, 164, 166, 126, 140, 1, 151, 233, 52, 69, 70,
+  71, 133, 131, 250,
+};
+
+// Both tables have to be the same size, array with negative size fails compilation otherwise
+typedef char sa__opcodesSortedSizeCheck_t[(sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED) / sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[0])) == (sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES) / sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES[0])) ? 1 : -1];
+
+// Generated from SA_ASSEMBLER_LOW_LEVEL_OPCODES, mnemonic, section instruction goes to, word count with opcode word, variadic, table index
+// One entry per opcode value in order (no designated initializers, so it builds as C++ too), holes have SA_NULL mnemonic
+const struct sa__assemblerOpcodeInfo_s SA_ASSEMBLER_OPCODE_INFO[SA_OPCODE_COUNT] = {
+  { "Nop",                               saSectionType_Functions,          1, SA_FALSE,   0 }, // saOp_Nop
+  { "Undef",                             saSectionType_Types,              3, SA_FALSE,   1 }, // saOp_Undef
+  { "SourceContinued",                   saSectionType_Debug,              2, SA_TRUE,    2 }, // saOp_SourceContinued
+  { "Source",                            saSectionType_Debug,              3, SA_TRUE,    3 }, // saOp_Source
+  { "SourceExtension",                   saSectionType_Debug,              2, SA_TRUE,    4 }, // saOp_SourceExtension
+  { "Name",                              saSectionType_Debug,              3, SA_TRUE,    5 }, // saOp_Name
+  { "MemberName",                        saSectionType_Debug,              4, SA_TRUE,    6 }, // saOp_MemberName
+  { "String",                            saSectionType_Debug,              3, SA_TRUE,    7 }, // saOp_String
+  { "Line",                              saSectionType_Types,              4, SA_FALSE,   8 }, // saOp_Line
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "Extension",                         saSectionType_Extensions,         2, SA_TRUE,    9 }, // saOp_Extension
+  { "ExtInstImport",                     saSectionType_Imports,            3, SA_TRUE,   10 }, // saOp_ExtInstImport
+  { "ExtInst",                           saSectionType_Functions,          5, SA_TRUE,   11 }, // saOp_ExtInst
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "MemoryModel",                       saSectionType_MemoryModel,        3, SA_FALSE,  12 }, // saOp_MemoryModel
+  { "EntryPoint",                        saSectionType_EntryPoints,        4, SA_TRUE,   13 }, // saOp_EntryPoint
+  { "ExecutionMode",                     saSectionType_ExecutionModes,     3, SA_TRUE,   14 }, // saOp_ExecutionMode
+  { "Capability",                        saSectionType_Capability,         2, SA_FALSE,  15 }, // saOp_Capability
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "TypeVoid",                          saSectionType_Types,              2, SA_FALSE,  16 }, // saOp_TypeVoid
+  { "TypeBool",                          saSectionType_Types,              2, SA_FALSE,  17 }, // saOp_TypeBool
+  { "TypeInt",                           saSectionType_Types,              4, SA_FALSE,  18 }, // saOp_TypeInt
+  { "TypeFloat",                         saSectionType_Types,              3, SA_TRUE,   19 }, // saOp_TypeFloat
+  { "TypeVector",                        saSectionType_Types,              4, SA_FALSE,  20 }, // saOp_TypeVector
+  { "TypeMatrix",                        saSectionType_Types,              4, SA_FALSE,  21 }, // saOp_TypeMatrix
+  { "TypeImage",                         saSectionType_Types,              9, SA_TRUE,   22 }, // saOp_TypeImage
+  { "TypeSampler",                       saSectionType_Types,              2, SA_FALSE,  23 }, // saOp_TypeSampler
+  { "TypeSampledImage",                  saSectionType_Types,              3, SA_FALSE,  24 }, // saOp_TypeSampledImage
+  { "TypeArray",                         saSectionType_Types,              4, SA_FALSE,  25 }, // saOp_TypeArray
+  { "TypeRuntimeArray",                  saSectionType_Types,              3, SA_FALSE,  26 }, // saOp_TypeRuntimeArray
+  { "TypeStruct",                        saSectionType_Types,              2, SA_TRUE,   27 }, // saOp_TypeStruct
+  { "TypeOpaque",                        saSectionType_Types,              3, SA_TRUE,   28 }, // saOp_TypeOpaque
+  { "TypePointer",                       saSectionType_Types,              4, SA_FALSE,  29 }, // saOp_TypePointer
+  { "TypeFunction",                      saSectionType_Types,              3, SA_TRUE,   30 }, // saOp_TypeFunction
+  { "TypeEvent",                         saSectionType_Types,              2, SA_FALSE,  31 }, // saOp_TypeEvent
+  { "TypeDeviceEvent",                   saSectionType_Types,              2, SA_FALSE,  32 }, // saOp_TypeDeviceEvent
+  { "TypeReserveId",                     saSectionType_Types,              2, SA_FALSE,  33 }, // saOp_TypeReserveId
+  { "TypeQueue",                         saSectionType_Types,              2, SA_FALSE,  34 }, // saOp_TypeQueue
+  { "TypePipe",                          saSectionType_Types,              3, SA_FALSE,  35 }, // saOp_TypePipe
+  { "TypeForwardPointer",                saSectionType_Types,              3, SA_FALSE,  36 }, // saOp_TypeForwardPointer
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "ConstantTrue",                      saSectionType_Types,              3, SA_FALSE,  37 }, // saOp_ConstantTrue
+  { "ConstantFalse",                     saSectionType_Types,              3, SA_FALSE,  38 }, // saOp_ConstantFalse
+  { "Constant",                          saSectionType_Types,              4, SA_TRUE,   39 }, // saOp_Constant
+  { "ConstantComposite",                 saSectionType_Types,              3, SA_TRUE,   40 }, // saOp_ConstantComposite
+  { "ConstantSampler",                   saSectionType_Types,              6, SA_FALSE,  41 }, // saOp_ConstantSampler
+  { "ConstantNull",                      saSectionType_Types,              3, SA_FALSE,  42 }, // saOp_ConstantNull
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "SpecConstantTrue",                  saSectionType_Functions,          3, SA_FALSE,  43 }, // saOp_SpecConstantTrue
+  { "SpecConstantFalse",                 saSectionType_Functions,          3, SA_FALSE,  44 }, // saOp_SpecConstantFalse
+  { "SpecConstant",                      saSectionType_Functions,          4, SA_TRUE,   45 }, // saOp_SpecConstant
+  { "SpecConstantComposite",             saSectionType_Functions,          3, SA_TRUE,   46 }, // saOp_SpecConstantComposite
+  { "SpecConstantOp",                    saSectionType_Functions,          4, SA_TRUE,   47 }, // saOp_SpecConstantOp
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "Function",                          saSectionType_Functions,          5, SA_FALSE,  48 }, // saOp_Function
+  { "FunctionParameter",                 saSectionType_Functions,          3, SA_FALSE,  49 }, // saOp_FunctionParameter
+  { "FunctionEnd",                       saSectionType_Functions,          1, SA_FALSE,  50 }, // saOp_FunctionEnd
+  { "FunctionCall",                      saSectionType_Functions,          4, SA_TRUE,   51 }, // saOp_FunctionCall
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "Variable",                          saSectionType_Types,              4, SA_TRUE,   52 }, // saOp_Variable
+  { "ImageTexelPointer",                 saSectionType_Functions,          6, SA_FALSE,  53 }, // saOp_ImageTexelPointer
+  { "Load",                              saSectionType_Functions,          4, SA_TRUE,   54 }, // saOp_Load
+  { "Store",                             saSectionType_Functions,          3, SA_TRUE,   55 }, // saOp_Store
+  { "CopyMemory",                        saSectionType_Functions,          3, SA_TRUE,   56 }, // saOp_CopyMemory
+  { "CopyMemorySized",                   saSectionType_Functions,          4, SA_TRUE,   57 }, // saOp_CopyMemorySized
+  { "AccessChain",                       saSectionType_Functions,          4, SA_TRUE,   58 }, // saOp_AccessChain
+  { "InBoundsAccessChain",               saSectionType_Functions,          4, SA_TRUE,   59 }, // saOp_InBoundsAccessChain
+  { "PtrAccessChain",                    saSectionType_Functions,          5, SA_TRUE,   60 }, // saOp_PtrAccessChain
+  { "ArrayLength",                       saSectionType_Functions,          5, SA_FALSE,  61 }, // saOp_ArrayLength
+  { "GenericPtrMemSemantics",            saSectionType_Functions,          4, SA_FALSE,  62 }, // saOp_GenericPtrMemSemantics
+  { "InBoundsPtrAccessChain",            saSectionType_Functions,          5, SA_TRUE,   63 }, // saOp_InBoundsPtrAccessChain
+  { "Decorate",                          saSectionType_Annotations,        3, SA_TRUE,   64 }, // saOp_Decorate
+  { "MemberDecorate",                    saSectionType_Annotations,        4, SA_TRUE,   65 }, // saOp_MemberDecorate
+  { "DecorationGroup",                   saSectionType_Annotations,        2, SA_FALSE,  66 }, // saOp_DecorationGroup
+  { "GroupDecorate",                     saSectionType_Annotations,        2, SA_TRUE,   67 }, // saOp_GroupDecorate
+  { "GroupMemberDecorate",               saSectionType_Annotations,        2, SA_TRUE,   68 }, // saOp_GroupMemberDecorate
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "VectorExtractDynamic",              saSectionType_Functions,          5, SA_FALSE,  69 }, // saOp_VectorExtractDynamic
+  { "VectorInsertDynamic",               saSectionType_Functions,          6, SA_FALSE,  70 }, // saOp_VectorInsertDynamic
+  { "VectorShuffle",                     saSectionType_Functions,          5, SA_TRUE,   71 }, // saOp_VectorShuffle
+  { "CompositeConstruct",                saSectionType_Functions,          3, SA_TRUE,   72 }, // saOp_CompositeConstruct
+  { "CompositeExtract",                  saSectionType_Functions,          4, SA_TRUE,   73 }, // saOp_CompositeExtract
+  { "CompositeInsert",                   saSectionType_Functions,          5, SA_TRUE,   74 }, // saOp_CompositeInsert
+  { "CopyObject",                        saSectionType_Functions,          4, SA_FALSE,  75 }, // saOp_CopyObject
+  { "Transpose",                         saSectionType_Functions,          4, SA_FALSE,  76 }, // saOp_Transpose
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "SampledImage",                      saSectionType_Functions,          5, SA_FALSE,  77 }, // saOp_SampledImage
+  { "ImageSampleImplicitLod",            saSectionType_Functions,          5, SA_TRUE,   78 }, // saOp_ImageSampleImplicitLod
+  { "ImageSampleExplicitLod",            saSectionType_Functions,          7, SA_TRUE,   79 }, // saOp_ImageSampleExplicitLod
+  { "ImageSampleDrefImplicitLod",        saSectionType_Functions,          6, SA_TRUE,   80 }, // saOp_ImageSampleDrefImplicitLod
+  { "ImageSampleDrefExplicitLod",        saSectionType_Functions,          8, SA_TRUE,   81 }, // saOp_ImageSampleDrefExplicitLod
+  { "ImageSampleProjImplicitLod",        saSectionType_Functions,          5, SA_TRUE,   82 }, // saOp_ImageSampleProjImplicitLod
+  { "ImageSampleProjExplicitLod",        saSectionType_Functions,          7, SA_TRUE,   83 }, // saOp_ImageSampleProjExplicitLod
+  { "ImageSampleProjDrefImplicitLod",    saSectionType_Functions,          6, SA_TRUE,   84 }, // saOp_ImageSampleProjDrefImplicitLod
+  { "ImageSampleProjDrefExplicitLod",    saSectionType_Functions,          8, SA_TRUE,   85 }, // saOp_ImageSampleProjDrefExplicitLod
+  { "ImageFetch",                        saSectionType_Functions,          5, SA_TRUE,   86 }, // saOp_ImageFetch
+  { "ImageGather",                       saSectionType_Functions,          6, SA_TRUE,   87 }, // saOp_ImageGather
+  { "ImageDrefGather",                   saSectionType_Functions,          6, SA_TRUE,   88 }, // saOp_ImageDrefGather
+  { "ImageRead",                         saSectionType_Functions,          5, SA_TRUE,   89 }, // saOp_ImageRead
+  { "ImageWrite",                        saSectionType_Functions,          4, SA_TRUE,   90 }, // saOp_ImageWrite
+  { "Image",                             saSectionType_Functions,          4, SA_FALSE,  91 }, // saOp_Image
+  { "ImageQueryFormat",                  saSectionType_Functions,          4, SA_FALSE,  92 }, // saOp_ImageQueryFormat
+  { "ImageQueryOrder",                   saSectionType_Functions,          4, SA_FALSE,  93 }, // saOp_ImageQueryOrder
+  { "ImageQuerySizeLod",                 saSectionType_Functions,          5, SA_FALSE,  94 }, // saOp_ImageQuerySizeLod
+  { "ImageQuerySize",                    saSectionType_Functions,          4, SA_FALSE,  95 }, // saOp_ImageQuerySize
+  { "ImageQueryLod",                     saSectionType_Functions,          5, SA_FALSE,  96 }, // saOp_ImageQueryLod
+  { "ImageQueryLevels",                  saSectionType_Functions,          4, SA_FALSE,  97 }, // saOp_ImageQueryLevels
+  { "ImageQuerySamples",                 saSectionType_Functions,          4, SA_FALSE,  98 }, // saOp_ImageQuerySamples
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "ConvertFToU",                       saSectionType_Functions,          4, SA_FALSE,  99 }, // saOp_ConvertFToU
+  { "ConvertFToS",                       saSectionType_Functions,          4, SA_FALSE, 100 }, // saOp_ConvertFToS
+  { "ConvertSToF",                       saSectionType_Functions,          4, SA_FALSE, 101 }, // saOp_ConvertSToF
+  { "ConvertUToF",                       saSectionType_Functions,          4, SA_FALSE, 102 }, // saOp_ConvertUToF
+  { "UConvert",                          saSectionType_Functions,          4, SA_FALSE, 103 }, // saOp_UConvert
+  { "SConvert",                          saSectionType_Functions,          4, SA_FALSE, 104 }, // saOp_SConvert
+  { "FConvert",                          saSectionType_Functions,          4, SA_FALSE, 105 }, // saOp_FConvert
+  { "QuantizeToF16",                     saSectionType_Functions,          4, SA_FALSE, 106 }, // saOp_QuantizeToF16
+  { "ConvertPtrToU",                     saSectionType_Functions,          4, SA_FALSE, 107 }, // saOp_ConvertPtrToU
+  { "SatConvertSToU",                    saSectionType_Functions,          4, SA_FALSE, 108 }, // saOp_SatConvertSToU
+  { "SatConvertUToS",                    saSectionType_Functions,          4, SA_FALSE, 109 }, // saOp_SatConvertUToS
+  { "ConvertUToPtr",                     saSectionType_Functions,          4, SA_FALSE, 110 }, // saOp_ConvertUToPtr
+  { "PtrCastToGeneric",                  saSectionType_Functions,          4, SA_FALSE, 111 }, // saOp_PtrCastToGeneric
+  { "GenericCastToPtr",                  saSectionType_Functions,          4, SA_FALSE, 112 }, // saOp_GenericCastToPtr
+  { "GenericCastToPtrExplicit",          saSectionType_Functions,          5, SA_FALSE, 113 }, // saOp_GenericCastToPtrExplicit
+  { "Bitcast",                           saSectionType_Functions,          4, SA_FALSE, 114 }, // saOp_Bitcast
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "SNegate",                           saSectionType_Functions,          4, SA_FALSE, 115 }, // saOp_SNegate
+  { "FNegate",                           saSectionType_Functions,          4, SA_FALSE, 116 }, // saOp_FNegate
+  { "IAdd",                              saSectionType_Functions,          5, SA_FALSE, 117 }, // saOp_IAdd
+  { "FAdd",                              saSectionType_Functions,          5, SA_FALSE, 118 }, // saOp_FAdd
+  { "ISub",                              saSectionType_Functions,          5, SA_FALSE, 119 }, // saOp_ISub
+  { "FSub",                              saSectionType_Functions,          5, SA_FALSE, 120 }, // saOp_FSub
+  { "IMul",                              saSectionType_Functions,          5, SA_FALSE, 121 }, // saOp_IMul
+  { "FMul",                              saSectionType_Functions,          5, SA_FALSE, 122 }, // saOp_FMul
+  { "UDiv",                              saSectionType_Functions,          5, SA_FALSE, 123 }, // saOp_UDiv
+  { "SDiv",                              saSectionType_Functions,          5, SA_FALSE, 124 }, // saOp_SDiv
+  { "FDiv",                              saSectionType_Functions,          5, SA_FALSE, 125 }, // saOp_FDiv
+  { "UMul",                              saSectionType_Functions,          5, SA_FALSE, 126 }, // saOp_UMul
+  { "SRem",                              saSectionType_Functions,          5, SA_FALSE, 127 }, // saOp_SRem
+  { "SMod",                              saSectionType_Functions,          5, SA_FALSE, 128 }, // saOp_SMod
+  { "FRem",                              saSectionType_Functions,          5, SA_FALSE, 129 }, // saOp_FRem
+  { "FMod",                              saSectionType_Functions,          5, SA_FALSE, 130 }, // saOp_FMod
+  { "VectorTimesScalar",                 saSectionType_Functions,          5, SA_FALSE, 131 }, // saOp_VectorTimesScalar
+  { "MatrixTimesScalar",                 saSectionType_Functions,          5, SA_FALSE, 132 }, // saOp_MatrixTimesScalar
+  { "VectorTimesMatrix",                 saSectionType_Functions,          5, SA_FALSE, 133 }, // saOp_VectorTimesMatrix
+  { "MatrixTimesVector",                 saSectionType_Functions,          5, SA_FALSE, 134 }, // saOp_MatrixTimesVector
+  { "MatrixTimesMatrix",                 saSectionType_Functions,          5, SA_FALSE, 135 }, // saOp_MatrixTimesMatrix
+  { "OuterProduct",                      saSectionType_Functions,          5, SA_FALSE, 136 }, // saOp_OuterProduct
+  { "Dot",                               saSectionType_Functions,          5, SA_FALSE, 137 }, // saOp_Dot
+  { "IAddCarry",                         saSectionType_Functions,          5, SA_FALSE, 138 }, // saOp_IAddCarry
+  { "ISubBorrow",                        saSectionType_Functions,          5, SA_FALSE, 139 }, // saOp_ISubBorrow
+  { "UMulExtended",                      saSectionType_Functions,          5, SA_FALSE, 140 }, // saOp_UMulExtended
+  { "SMulExtended",                      saSectionType_Functions,          5, SA_FALSE, 141 }, // saOp_SMulExtended
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "Any",                               saSectionType_Functions,          4, SA_FALSE, 142 }, // saOp_Any
+  { "All",                               saSectionType_Functions,          4, SA_FALSE, 143 }, // saOp_All
+  { "IsNan",                             saSectionType_Functions,          4, SA_FALSE, 144 }, // saOp_IsNan
+  { "IsInf",                             saSectionType_Functions,          4, SA_FALSE, 145 }, // saOp_IsInf
+  { "IsFinite",                          saSectionType_Functions,          4, SA_FALSE, 146 }, // saOp_IsFinite
+  { "IsNormal",                          saSectionType_Functions,          4, SA_FALSE, 147 }, // saOp_IsNormal
+  { "SignBitSet",                        saSectionType_Functions,          4, SA_FALSE, 148 }, // saOp_SignBitSet
+  { "LessOrGreater",                     saSectionType_Functions,          5, SA_FALSE, 149 }, // saOp_LessOrGreater
+  { "Ordered",                           saSectionType_Functions,          5, SA_FALSE, 150 }, // saOp_Ordered
+  { "Unordered",                         saSectionType_Functions,          5, SA_FALSE, 151 }, // saOp_Unordered
+  { "LogicalEqual",                      saSectionType_Functions,          5, SA_FALSE, 152 }, // saOp_LogicalEqual
+  { "LogicalNotEqual",                   saSectionType_Functions,          5, SA_FALSE, 153 }, // saOp_LogicalNotEqual
+  { "LogicalOr",                         saSectionType_Functions,          5, SA_FALSE, 154 }, // saOp_LogicalOr
+  { "LogicalAnd",                        saSectionType_Functions,          5, SA_FALSE, 155 }, // saOp_LogicalAnd
+  { "LogicalNot",                        saSectionType_Functions,          4, SA_FALSE, 156 }, // saOp_LogicalNot
+  { "Select",                            saSectionType_Functions,          6, SA_FALSE, 157 }, // saOp_Select
+  { "IEqual",                            saSectionType_Functions,          5, SA_FALSE, 158 }, // saOp_IEqual
+  { "INotEqual",                         saSectionType_Functions,          5, SA_FALSE, 159 }, // saOp_INotEqual
+  { "UGreaterThan",                      saSectionType_Functions,          5, SA_FALSE, 160 }, // saOp_UGreaterThan
+  { "SGreaterThan",                      saSectionType_Functions,          5, SA_FALSE, 161 }, // saOp_SGreaterThan
+  { "UGreaterThanEqual",                 saSectionType_Functions,          5, SA_FALSE, 162 }, // saOp_UGreaterThanEqual
+  { "SGreaterThanEqual",                 saSectionType_Functions,          5, SA_FALSE, 163 }, // saOp_SGreaterThanEqual
+  { "ULessThan",                         saSectionType_Functions,          5, SA_FALSE, 164 }, // saOp_ULessThan
+  { "SLessThan",                         saSectionType_Functions,          5, SA_FALSE, 165 }, // saOp_SLessThan
+  { "ULessThanEqual",                    saSectionType_Functions,          5, SA_FALSE, 166 }, // saOp_ULessThanEqual
+  { "SLessThanEqual",                    saSectionType_Functions,          5, SA_FALSE, 167 }, // saOp_SLessThanEqual
+  { "FOrdEqual",                         saSectionType_Functions,          5, SA_FALSE, 168 }, // saOp_FOrdEqual
+  { "FUnordEqual",                       saSectionType_Functions,          5, SA_FALSE, 169 }, // saOp_FUnordEqual
+  { "FOrdNotEqual",                      saSectionType_Functions,          5, SA_FALSE, 170 }, // saOp_FOrdNotEqual
+  { "FUnordNotEqual",                    saSectionType_Functions,          5, SA_FALSE, 171 }, // saOp_FUnordNotEqual
+  { "FOrdLessThan",                      saSectionType_Functions,          5, SA_FALSE, 172 }, // saOp_FOrdLessThan
+  { "FUnordLessThan",                    saSectionType_Functions,          5, SA_FALSE, 173 }, // saOp_FUnordLessThan
+  { "FOrdGreaterThan",                   saSectionType_Functions,          5, SA_FALSE, 174 }, // saOp_FOrdGreaterThan
+  { "FUnordGreaterThan",                 saSectionType_Functions,          5, SA_FALSE, 175 }, // saOp_FUnordGreaterThan
+  { "FOrdLessThanEqual",                 saSectionType_Functions,          5, SA_FALSE, 176 }, // saOp_FOrdLessThanEqual
+  { "FUnordLessThanEqual",               saSectionType_Functions,          5, SA_FALSE, 177 }, // saOp_FUnordLessThanEqual
+  { "FOrdGreaterThanEqual",              saSectionType_Functions,          5, SA_FALSE, 178 }, // saOp_FOrdGreaterThanEqual
+  { "FUnordGreaterThanEqual",            saSectionType_Functions,          5, SA_FALSE, 179 }, // saOp_FUnordGreaterThanEqual
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "ShiftRightLogical",                 saSectionType_Functions,          5, SA_FALSE, 180 }, // saOp_ShiftRightLogical
+  { "ShiftRightArithmetic",              saSectionType_Functions,          5, SA_FALSE, 181 }, // saOp_ShiftRightArithmetic
+  { "ShiftLeftLogical",                  saSectionType_Functions,          5, SA_FALSE, 182 }, // saOp_ShiftLeftLogical
+  { "BitwiseOr",                         saSectionType_Functions,          5, SA_FALSE, 183 }, // saOp_BitwiseOr
+  { "BitwiseXor",                        saSectionType_Functions,          5, SA_FALSE, 184 }, // saOp_BitwiseXor
+  { "BitwiseAnd",                        saSectionType_Functions,          5, SA_FALSE, 185 }, // saOp_BitwiseAnd
+  { "Not",                               saSectionType_Functions,          4, SA_FALSE, 186 }, // saOp_Not
+  { "BitFieldInsert",                    saSectionType_Functions,          7, SA_FALSE, 187 }, // saOp_BitFieldInsert
+  { "BitFieldSExtract",                  saSectionType_Functions,          6, SA_FALSE, 188 }, // saOp_BitFieldSExtract
+  { "BitFieldUExtract",                  saSectionType_Functions,          6, SA_FALSE, 189 }, // saOp_BitFieldUExtract
+  { "BitReverse",                        saSectionType_Functions,          4, SA_FALSE, 190 }, // saOp_BitReverse
+  { "BitCount",                          saSectionType_Functions,          4, SA_FALSE, 191 }, // saOp_BitCount
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "DPdx",                              saSectionType_Functions,          4, SA_FALSE, 192 }, // saOp_DPdx
+  { "DPdy",                              saSectionType_Functions,          4, SA_FALSE, 193 }, // saOp_DPdy
+  { "Fwidth",                            saSectionType_Functions,          4, SA_FALSE, 194 }, // saOp_Fwidth
+  { "DPdxFine",                          saSectionType_Functions,          4, SA_FALSE, 195 }, // saOp_DPdxFine
+  { "DPdyFine",                          saSectionType_Functions,          4, SA_FALSE, 196 }, // saOp_DPdyFine
+  { "FwidthFine",                        saSectionType_Functions,          4, SA_FALSE, 197 }, // saOp_FwidthFine
+  { "DPdxCoarse",                        saSectionType_Functions,          4, SA_FALSE, 198 }, // saOp_DPdxCoarse
+  { "DPdyCoarse",                        saSectionType_Functions,          4, SA_FALSE, 199 }, // saOp_DPdyCoarse
+  { "FwidthCoarse",                      saSectionType_Functions,          4, SA_FALSE, 200 }, // saOp_FwidthCoarse
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "EmitVertex",                        saSectionType_Functions,          1, SA_FALSE, 201 }, // saOp_EmitVertex
+  { "EndPrimitive",                      saSectionType_Functions,          1, SA_FALSE, 202 }, // saOp_EndPrimitive
+  { "EmitStreamVertex",                  saSectionType_Functions,          2, SA_FALSE, 203 }, // saOp_EmitStreamVertex
+  { "EndStreamPrimitive",                saSectionType_Functions,          2, SA_FALSE, 204 }, // saOp_EndStreamPrimitive
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "ControlBarrier",                    saSectionType_Functions,          4, SA_FALSE, 205 }, // saOp_ControlBarrier
+  { "MemoryBarrier",                     saSectionType_Functions,          3, SA_FALSE, 206 }, // saOp_MemoryBarrier
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "AtomicLoad",                        saSectionType_Functions,          6, SA_FALSE, 207 }, // saOp_AtomicLoad
+  { "AtomicStore",                       saSectionType_Functions,          5, SA_FALSE, 208 }, // saOp_AtomicStore
+  { "AtomicExchange",                    saSectionType_Functions,          7, SA_FALSE, 209 }, // saOp_AtomicExchange
+  { "AtomicCompareExchange",             saSectionType_Functions,          9, SA_FALSE, 210 }, // saOp_AtomicCompareExchange
+  { "AtomicCompareExchangeWeak",         saSectionType_Functions,          9, SA_FALSE, 211 }, // saOp_AtomicCompareExchangeWeak
+  { "AtomicIIncrement",                  saSectionType_Functions,          6, SA_FALSE, 212 }, // saOp_AtomicIIncrement
+  { "AtomicIDecrement",                  saSectionType_Functions,          6, SA_FALSE, 213 }, // saOp_AtomicIDecrement
+  { "AtomicIAdd",                        saSectionType_Functions,          7, SA_FALSE, 214 }, // saOp_AtomicIAdd
+  { "AtomicISub",                        saSectionType_Functions,          7, SA_FALSE, 215 }, // saOp_AtomicISub
+  { "AtomicSMin",                        saSectionType_Functions,          7, SA_FALSE, 216 }, // saOp_AtomicSMin
+  { "AtomicUMin",                        saSectionType_Functions,          7, SA_FALSE, 217 }, // saOp_AtomicUMin
+  { "AtomicSMax",                        saSectionType_Functions,          7, SA_FALSE, 218 }, // saOp_AtomicSMax
+  { "AtomicUMax",                        saSectionType_Functions,          7, SA_FALSE, 219 }, // saOp_AtomicUMax
+  { "AtomicAnd",                         saSectionType_Functions,          7, SA_FALSE, 220 }, // saOp_AtomicAnd
+  { "AtomicOr",                          saSectionType_Functions,          7, SA_FALSE, 221 }, // saOp_AtomicOr
+  { "AtomicXor",                         saSectionType_Functions,          7, SA_FALSE, 222 }, // saOp_AtomicXor
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "Phi",                               saSectionType_Functions,          3, SA_TRUE,  223 }, // saOp_Phi
+  { "LoopMerge",                         saSectionType_Functions,          4, SA_TRUE,  224 }, // saOp_LoopMerge
+  { "SelectionMerge",                    saSectionType_Functions,          3, SA_FALSE, 225 }, // saOp_SelectionMerge
+  { "Label",                             saSectionType_Functions,          2, SA_FALSE, 226 }, // saOp_Label
+  { "Branch",                            saSectionType_Functions,          2, SA_FALSE, 227 }, // saOp_Branch
+  { "BranchConditional",                 saSectionType_Functions,          4, SA_TRUE,  228 }, // saOp_BranchConditional
+  { "Switch",                            saSectionType_Functions,          3, SA_TRUE,  229 }, // saOp_Switch
+  { "Kill",                              saSectionType_Functions,          1, SA_FALSE, 230 }, // saOp_Kill
+  { "Return",                            saSectionType_Functions,          1, SA_FALSE, 231 }, // saOp_Return
+  { "ReturnValue",                       saSectionType_Functions,          2, SA_FALSE, 232 }, // saOp_ReturnValue
+  { "Unreachable",                       saSectionType_Functions,          1, SA_FALSE, 233 }, // saOp_Unreachable
+  { "LifetimeStart",                     saSectionType_Functions,          3, SA_FALSE, 234 }, // saOp_LifetimeStart
+  { "LifetimeStop",                      saSectionType_Functions,          3, SA_FALSE, 235 }, // saOp_LifetimeStop
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "GroupAsyncCopy",                    saSectionType_Functions,          9, SA_FALSE, 236 }, // saOp_GroupAsyncCopy
+  { "GroupWaitEvents",                   saSectionType_Functions,          4, SA_FALSE, 237 }, // saOp_GroupWaitEvents
+  { "GroupAll",                          saSectionType_Functions,          5, SA_FALSE, 238 }, // saOp_GroupAll
+  { "GroupAny",                          saSectionType_Functions,          5, SA_FALSE, 239 }, // saOp_GroupAny
+  { "GroupBroadcast",                    saSectionType_Functions,          6, SA_FALSE, 240 }, // saOp_GroupBroadcast
+  { "GroupIAdd",                         saSectionType_Functions,          6, SA_FALSE, 241 }, // saOp_GroupIAdd
+  { "GroupFAdd",                         saSectionType_Functions,          6, SA_FALSE, 242 }, // saOp_GroupFAdd
+  { "GroupFMin",                         saSectionType_Functions,          6, SA_FALSE, 243 }, // saOp_GroupFMin
+  { "GroupUMin",                         saSectionType_Functions,          6, SA_FALSE, 244 }, // saOp_GroupUMin
+  { "GroupSMin",                         saSectionType_Functions,          6, SA_FALSE, 245 }, // saOp_GroupSMin
+  { "GroupFMax",                         saSectionType_Functions,          6, SA_FALSE, 246 }, // saOp_GroupFMax
+  { "GroupUMax",                         saSectionType_Functions,          6, SA_FALSE, 247 }, // saOp_GroupUMax
+  { "GroupSMax",                         saSectionType_Functions,          6, SA_FALSE, 248 }, // saOp_GroupSMax
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "ReadPipe",                          saSectionType_Functions,          7, SA_FALSE, 249 }, // saOp_ReadPipe
+  { "WritePipe",                         saSectionType_Functions,          7, SA_FALSE, 250 }, // saOp_WritePipe
+  { "ReservedReadPipe",                  saSectionType_Functions,          9, SA_FALSE, 251 }, // saOp_ReservedReadPipe
+  { "ReservedWritePipe",                 saSectionType_Functions,          9, SA_FALSE, 252 }, // saOp_ReservedWritePipe
+  { "ReservedReadPipePackets",           saSectionType_Functions,          7, SA_FALSE, 253 }, // saOp_ReservedReadPipePackets
+  { "ReservedWritePipePackets",          saSectionType_Functions,          7, SA_FALSE, 254 }, // saOp_ReservedWritePipePackets
+  { "CommitReadPipe",                    saSectionType_Functions,          5, SA_FALSE, 255 }, // saOp_CommitReadPipe
+  { "CommitWritePipe",                   saSectionType_Functions,          5, SA_FALSE, 256 }, // saOp_CommitWritePipe
+  { "IsValidReservedId",                 saSectionType_Functions,          4, SA_FALSE, 257 }, // saOp_IsValidReservedId
+  { "GetNumPipePackets",                 saSectionType_Functions,          6, SA_FALSE, 258 }, // saOp_GetNumPipePackets
+  { "GetMaxPipePackets",                 saSectionType_Functions,          6, SA_FALSE, 259 }, // saOp_GetMaxPipePackets
+  { "GroupReserveReadPipePackets",       saSectionType_Functions,          8, SA_FALSE, 260 }, // saOp_GroupReserveReadPipePackets
+  { "GroupReserveWritePipePackets",      saSectionType_Functions,          8, SA_FALSE, 261 }, // saOp_GroupReserveWritePipePackets
+  { "GroupCommitReadPipe",               saSectionType_Functions,          6, SA_FALSE, 262 }, // saOp_GroupCommitReadPipe
+  { "GroupCommitWritePipe",              saSectionType_Functions,          6, SA_FALSE, 263 }, // saOp_GroupCommitWritePipe
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "EnqueueMarker",                     saSectionType_Functions,          7, SA_FALSE, 264 }, // saOp_EnqueueMarker
+  { "EnqueueKernel",                     saSectionType_Functions,         13, SA_TRUE,  265 }, // saOp_EnqueueKernel
+  { "GetKernelINDrangeSubGroupCount",    saSectionType_Functions,          8, SA_FALSE, 266 }, // saOp_GetKernelINDrangeSubGroupCount
+  { "GetKernelINDrangeMaxSubGroupSize",  saSectionType_Functions,          8, SA_FALSE, 267 }, // saOp_GetKernelINDrangeMaxSubGroupSize
+  { "GetKernelIWorkGroupSize",           saSectionType_Functions,          7, SA_FALSE, 268 }, // saOp_GetKernelIWorkGroupSize
+  { "GetKernelIPreferredWorkGroupSizeMultiple", saSectionType_Functions,          7, SA_FALSE, 269 }, // saOp_GetKernelIPreferredWorkGroupSizeMultiple
+  { "RetainEvent",                       saSectionType_Functions,          2, SA_FALSE, 270 }, // saOp_RetainEvent
+  { "ReleaseEvent",                      saSectionType_Functions,          2, SA_FALSE, 271 }, // saOp_ReleaseEvent
+  { "CreateUserEvent",                   saSectionType_Functions,          3, SA_FALSE, 272 }, // saOp_CreateUserEvent
+  { "IsValidEvent",                      saSectionType_Functions,          4, SA_FALSE, 273 }, // saOp_IsValidEvent
+  { "SetUserEventStatus",                saSectionType_Functions,          3, SA_FALSE, 274 }, // saOp_SetUserEventStatus
+  { "CaptureEventProfilingInfo",         saSectionType_Functions,          4, SA_FALSE, 275 }, // saOp_CaptureEventProfilingInfo
+  { "GetDefaultQueue",                   saSectionType_Functions,          3, SA_FALSE, 276 }, // saOp_GetDefaultQueue
+  { "BuildNDRange",                      saSectionType_Functions,          6, SA_FALSE, 277 }, // saOp_BuildNDRange
+  { "ImageSparseSampleImplicitLod",      saSectionType_Functions,          5, SA_TRUE,  278 }, // saOp_ImageSparseSampleImplicitLod
+  { "ImageSparseSampleExplicitLod",      saSectionType_Functions,          7, SA_TRUE,  279 }, // saOp_ImageSparseSampleExplicitLod
+  { "ImageSparseSampleDrefImplicitLod",  saSectionType_Functions,          6, SA_TRUE,  280 }, // saOp_ImageSparseSampleDrefImplicitLod
+  { "ImageSparseSampleDrefExplicitLod",  saSectionType_Functions,          8, SA_TRUE,  281 }, // saOp_ImageSparseSampleDrefExplicitLod
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "ImageSparseFetch",                  saSectionType_Functions,          5, SA_TRUE,  282 }, // saOp_ImageSparseFetch
+  { "ImageSparseGather",                 saSectionType_Functions,          6, SA_TRUE,  283 }, // saOp_ImageSparseGather
+  { "ImageSparseDrefGather",             saSectionType_Functions,          6, SA_TRUE,  284 }, // saOp_ImageSparseDrefGather
+  { "ImageSparseTexelResident",          saSectionType_Functions,          4, SA_FALSE, 285 }, // saOp_ImageSparseTexelResident
+  { "NoLine",                            saSectionType_Functions,          1, SA_FALSE, 286 }, // saOp_NoLine
+  { "AtomicFlagTestAndSet",              saSectionType_Functions,          6, SA_FALSE, 287 }, // saOp_AtomicFlagTestAndSet
+  { "AtomicFlagClear",                   saSectionType_Functions,          4, SA_FALSE, 288 }, // saOp_AtomicFlagClear
+  { "ImageSparseRead",                   saSectionType_Functions,          5, SA_TRUE,  289 }, // saOp_ImageSparseRead
+  { "SizeOf",                            saSectionType_Functions,          4, SA_FALSE, 290 }, // saOp_SizeOf
+  { "TypePipeStorage",                   saSectionType_Types,              2, SA_FALSE, 291 }, // saOp_TypePipeStorage
+  { "ConstantPipeStorage",               saSectionType_Types,              6, SA_FALSE, 292 }, // saOp_ConstantPipeStorage
+  { "CreatePipeFromPipeStorage",         saSectionType_Functions,          4, SA_FALSE, 293 }, // saOp_CreatePipeFromPipeStorage
+  { "GetKernelLocalSizeForSubgroupCount", saSectionType_Functions,          8, SA_FALSE, 294 }, // saOp_GetKernelLocalSizeForSubgroupCount
+  { "GetKernelMaxNumSubgroups",          saSectionType_Functions,          7, SA_FALSE, 295 }, // saOp_GetKernelMaxNumSubgroups
+  { "TypeNamedBarrier",                  saSectionType_Types,              2, SA_FALSE, 296 }, // saOp_TypeNamedBarrier
+  { "NamedBarrierInitialize",            saSectionType_Functions,          4, SA_FALSE, 297 }, // saOp_NamedBarrierInitialize
+  { "MemoryNamedBarrier",                saSectionType_Functions,          4, SA_FALSE, 298 }, // saOp_MemoryNamedBarrier
+  { "ModuleProcessed",                   saSectionType_Debug,              2, SA_TRUE,  299 }, // saOp_ModuleProcessed
+  { "ExecutionModeId",                   saSectionType_ExecutionModes,     5, SA_TRUE,  300 }, // saOp_ExecutionModeId
+  { "DecorateId",                        saSectionType_Annotations,        3, SA_TRUE,  301 }, // saOp_DecorateId
+  { "GroupNonUniformElect",              saSectionType_Functions,          4, SA_FALSE, 302 }, // saOp_GroupNonUniformElect
+  { "GroupNonUniformAll",                saSectionType_Functions,          5, SA_FALSE, 303 }, // saOp_GroupNonUniformAll
+  { "GroupNonUniformAny",                saSectionType_Functions,          5, SA_FALSE, 304 }, // saOp_GroupNonUniformAny
+  { "GroupNonUniformAllEqual",           saSectionType_Functions,          5, SA_FALSE, 305 }, // saOp_GroupNonUniformAllEqual
+  { "GroupNonUniformBroadcast",          saSectionType_Functions,          6, SA_FALSE, 306 }, // saOp_GroupNonUniformBroadcast
+  { "GroupNonUniformBroadcastFirst",     saSectionType_Functions,          5, SA_FALSE, 307 }, // saOp_GroupNonUniformBroadcastFirst
+  { "GroupNonUniformBallot",             saSectionType_Functions,          5, SA_FALSE, 308 }, // saOp_GroupNonUniformBallot
+  { "GroupNonUniformInverseBallot",      saSectionType_Functions,          5, SA_FALSE, 309 }, // saOp_GroupNonUniformInverseBallot
+  { "GroupNonUniformBallotBitExtract",   saSectionType_Functions,          6, SA_FALSE, 310 }, // saOp_GroupNonUniformBallotBitExtract
+  { "GroupNonUniformBallotBitCount",     saSectionType_Functions,          6, SA_FALSE, 311 }, // saOp_GroupNonUniformBallotBitCount
+  { "GroupNonUniformBallotFindLSB",      saSectionType_Functions,          5, SA_FALSE, 312 }, // saOp_GroupNonUniformBallotFindLSB
+  { "GroupNonUniformBallotFindMSB",      saSectionType_Functions,          5, SA_FALSE, 313 }, // saOp_GroupNonUniformBallotFindMSB
+  { "GroupNonUniformShuffle",            saSectionType_Functions,          6, SA_FALSE, 314 }, // saOp_GroupNonUniformShuffle
+  { "GroupNonUniformShuffleXor",         saSectionType_Functions,          6, SA_FALSE, 315 }, // saOp_GroupNonUniformShuffleXor
+  { "GroupNonUniformShuffleUp",          saSectionType_Functions,          6, SA_FALSE, 316 }, // saOp_GroupNonUniformShuffleUp
+  { "GroupNonUniformShuffleDown",        saSectionType_Functions,          6, SA_FALSE, 317 }, // saOp_GroupNonUniformShuffleDown
+  { "GroupNonUniformIAdd",               saSectionType_Functions,          6, SA_TRUE,  318 }, // saOp_GroupNonUniformIAdd
+  { "GroupNonUniformFAdd",               saSectionType_Functions,          6, SA_TRUE,  319 }, // saOp_GroupNonUniformFAdd
+  { "GroupNonUniformIMul",               saSectionType_Functions,          6, SA_TRUE,  320 }, // saOp_GroupNonUniformIMul
+  { "GroupNonUniformFMul",               saSectionType_Functions,          6, SA_TRUE,  321 }, // saOp_GroupNonUniformFMul
+  { "GroupNonUniformSMin",               saSectionType_Functions,          6, SA_TRUE,  322 }, // saOp_GroupNonUniformSMin
+  { "GroupNonUniformUMin",               saSectionType_Functions,          6, SA_TRUE,  323 }, // saOp_GroupNonUniformUMin
+  { "GroupNonUniformFMin",               saSectionType_Functions,          6, SA_TRUE,  324 }, // saOp_GroupNonUniformFMin
+  { "GroupNonUniformSMax",               saSectionType_Functions,          6, SA_TRUE,  325 }, // saOp_GroupNonUniformSMax
+  { "GroupNonUniformUMax",               saSectionType_Functions,          6, SA_TRUE,  326 }, // saOp_GroupNonUniformUMax
+  { "GroupNonUniformFMax",               saSectionType_Functions,          6, SA_TRUE,  327 }, // saOp_GroupNonUniformFMax
+  { "GroupNonUniformBitwiseAnd",         saSectionType_Functions,          6, SA_TRUE,  328 }, // saOp_GroupNonUniformBitwiseAnd
+  { "GroupNonUniformBitwiseOr",          saSectionType_Functions,          6, SA_TRUE,  329 }, // saOp_GroupNonUniformBitwiseOr
+  { "GroupNonUniformBitwiseXor",         saSectionType_Functions,          6, SA_TRUE,  330 }, // saOp_GroupNonUniformBitwiseXor
+  { "GroupNonUniformLogicalAnd",         saSectionType_Functions,          6, SA_TRUE,  331 }, // saOp_GroupNonUniformLogicalAnd
+  { "GroupNonUniformLogicalOr",          saSectionType_Functions,          6, SA_TRUE,  332 }, // saOp_GroupNonUniformLogicalOr
+  { "GroupNonUniformLogicalXor",         saSectionType_Functions,          6, SA_TRUE,  333 }, // saOp_GroupNonUniformLogicalXor
+  { "GroupNonUniformQuadBroadcast",      saSectionType_Functions,          6, SA_FALSE, 334 }, // saOp_GroupNonUniformQuadBroadcast
+  { "GroupNonUniformQuadSwap",           saSectionType_Functions,          6, SA_FALSE, 335 }, // saOp_GroupNonUniformQuadSwap
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { SA_NULL,                             0,                                0, SA_FALSE,   0 },
+  { "CopyLogical",                       saSectionType_Functions,          4, SA_FALSE, 336 }, // saOp_CopyLogical
+  { "PtrEqual",                          saSectionType_Functions,          5, SA_FALSE, 337 }, // saOp_PtrEqual
+  { "PtrNotEqual",                       saSectionType_Functions,          5, SA_FALSE, 338 }, // saOp_PtrNotEqual
+  { "PtrDiff",                           saSectionType_Functions,          5, SA_FALSE, 339 }, // saOp_PtrDiff
+};
+
 // Table with all keywords possible in SPA
 const struct sa__assemblerLowLevelEnumerantConnection_s SA_ASSEMBLER_LOW_LEVEL_ENUMS[saAsmEnum_COUNT][SA_MAX_ENUMERANT_ENTRIES] = {
   {
@@ -2300,352 +2996,205 @@ const struct sa__assemblerLowLevelEnumerantConnection_s SA_ASSEMBLER_LOW_LEVEL_E
   }
 };
 
-// This is the big blob of every basic opcode, could be done better with some lookup table
+// Generated from SA_ASSEMBLER_LOW_LEVEL_ENUMS, regenerate when it changes, sa_checkTables() reports when they drift apart
+// Amount of entries in every SA_ASSEMBLER_LOW_LEVEL_ENUMS table
+const sa_uint8_t SA_ASSEMBLER_LOW_LEVEL_ENUMS_COUNT[saAsmEnum_COUNT] = {
+  18, 27, 8, 5, 2, 42, 20, 25, 17, 9, 4, 3, 3, 8, 47, 41, 3, 10, 5, 15, 7, 7, 4, 94, 80,
+};
+
+// Indices into SA_ASSEMBLER_LOW_LEVEL_ENUMS ordered by mnemonic (byte order), per enum kind
+const sa_uint8_t SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_NAME[saAsmEnum_COUNT][SA_MAX_ENUMERANT_ENTRIES] = {
+  {
+    12, 15, 13, 6, 4, 5, 3, 11, 7, 17, 9, 14, 10, 16, 8, 1, 2, 0,
+  },
+  {
+    10, 15, 24, 5, 25, 7, 8, 18, 22, 26, 11, 16, 19, 1, 14, 3, 21, 6, 9, 17,
+    20, 12, 23, 13, 2, 0, 4,
+  },
+  {
+    0, 1, 2, 5, 3, 4, 6, 7,
+  },
+  {
+    2, 1, 0, 3, 4,
+  },
+  {
+    1, 0,
+  },
+  {
+    8, 14, 19, 9, 28, 38, 3, 24, 33, 41, 40, 15, 20, 29, 39, 12, 17, 7, 26, 36,
+    6, 25, 35, 13, 18, 27, 37, 11, 34, 10, 16, 2, 22, 31, 1, 21, 30, 4, 5, 23,
+    32, 0,
+  },
+  {
+    1, 19, 7, 6, 13, 14, 8, 9, 0, 3, 2, 4, 5, 12, 11, 10, 18, 15, 17, 16,
+  },
+  {
+    14, 13, 8, 9, 7, 1, 0, 6, 16, 23, 24, 3, 15, 19, 2, 5, 4, 20, 21, 22,
+    11, 12, 10, 17, 18,
+  },
+  {
+    1, 4, 6, 3, 2, 9, 10, 8, 11, 0, 15, 5, 16, 7, 13, 12, 14,
+  },
+  {
+    6, 7, 4, 8, 5, 3, 0, 2, 1,
+  },
+  {
+    0, 3, 2, 1,
+  },
+  {
+    0, 1, 2,
+  },
+  {
+    0, 2, 1,
+  },
+  {
+    2, 4, 5, 7, 6, 1, 3, 0,
+  },
+  {
+    19, 43, 45, 6, 32, 2, 3, 11, 10, 15, 22, 5, 30, 21, 33, 39, 38, 13, 37, 9,
+    8, 31, 42, 17, 40, 29, 7, 44, 46, 41, 12, 24, 23, 34, 14, 0, 18, 4, 16, 27,
+    1, 28, 25, 26, 20, 35, 36,
+  },
+  {
+    2, 3, 30, 14, 20, 16, 26, 32, 31, 29, 21, 5, 40, 7, 8, 25, 27, 36, 35, 22,
+    13, 15, 1, 0, 6, 17, 19, 18, 37, 38, 34, 33, 12, 11, 10, 4, 39, 9, 28, 24,
+    23,
+  },
+  {
+    2, 1, 0,
+  },
+  {
+    3, 4, 2, 7, 6, 5, 0, 9, 8, 1,
+  },
+  {
+    4, 2, 1, 0, 3,
+  },
+  {
+    1, 3, 9, 8, 10, 12, 13, 0, 11, 2, 4, 6, 5, 14, 7,
+  },
+  {
+    2, 4, 5, 6, 0, 3, 1,
+  },
+  {
+    0, 1, 4, 5, 6, 3, 2,
+  },
+  {
+    3, 2, 1, 0,
+  },
+  {
+    50, 30, 44, 43, 13, 14, 12, 15, 68, 67, 48, 9, 87, 32, 79, 80, 31, 19, 20, 18,
+    21, 22, 0, 51, 24, 16, 17, 37, 36, 52, 55, 82, 81, 86, 91, 92, 90, 93, 83, 38,
+    39, 40, 84, 8, 7, 27, 65, 26, 66, 28, 69, 25, 6, 70, 71, 10, 42, 62, 23, 89,
+    63, 46, 78, 77, 47, 72, 73, 54, 74, 75, 64, 76, 45, 1, 2, 3, 53, 60, 57, 61,
+    58, 49, 59, 56, 88, 33, 41, 34, 35, 29, 5, 4, 11, 85,
+  },
+  {
+    16, 22, 15, 21, 17, 24, 23, 8, 13, 19, 66, 11, 32, 65, 26, 28, 3, 42, 39, 36,
+    45, 5, 68, 71, 72, 73, 7, 48, 9, 49, 50, 74, 76, 75, 31, 51, 64, 27, 29, 33,
+    34, 35, 79, 78, 77, 67, 57, 56, 54, 52, 55, 53, 25, 10, 69, 70, 0, 1, 4, 44,
+    41, 38, 6, 12, 18, 47, 30, 46, 14, 20, 2, 43, 40, 37, 63, 60, 58, 61, 59, 62,
+  },
+};
+
+// Indices into SA_ASSEMBLER_LOW_LEVEL_ENUMS ordered by value, aliases keep table order so first one is the canonical name
+const sa_uint8_t SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_VALUE[saAsmEnum_COUNT][SA_MAX_ENUMERANT_ENTRIES] = {
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25, 26,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7,
+  },
+  {
+    0, 1, 2, 3, 4,
+  },
+  {
+    0, 1,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40, 41,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8,
+  },
+  {
+    0, 1, 2, 3,
+  },
+  {
+    0, 1, 2,
+  },
+  {
+    0, 1, 2,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40, 41, 42, 43, 44, 45, 46,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40,
+  },
+  {
+    0, 1, 2,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+  },
+  {
+    0, 1, 2, 3, 4,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6,
+  },
+  {
+    0, 1, 2, 3,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59,
+    60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93,
+  },
+  {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59,
+    60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+  },
+};
+
 static const char* sa__opcodeToString(sa_uint16_t opcode) {
-  switch(opcode) {
-    case saOp_Nop: return "Nop"; break;
-    case saOp_Undef: return "Undef"; break;
-    case saOp_SourceContinued: return "SourceContinued"; break;
-    case saOp_Source: return "Source"; break;
-    case saOp_SourceExtension: return "SourceExtension"; break;
-    case saOp_Name: return "Name"; break;
-    case saOp_MemberName: return "MemberName"; break;
-    case saOp_String: return "String"; break;
-    case saOp_Line: return "Line"; break;
-    case saOp_Extension: return "Extension"; break;
-    case saOp_ExtInstImport: return "ExtInstImport"; break;
-    case saOp_ExtInst: return "ExtInst"; break;
-    case saOp_MemoryModel: return "MemoryModel"; break;
-    case saOp_EntryPoint: return "EntryPoint"; break;
-    case saOp_ExecutionMode: return "ExecutionMode"; break;
-    case saOp_Capability: return "Capability"; break;
-    case saOp_TypeVoid: return "TypeVoid"; break;
-    case saOp_TypeBool: return "TypeBool"; break;
-    case saOp_TypeInt: return "TypeInt"; break;
-    case saOp_TypeFloat: return "TypeFloat"; break;
-    case saOp_TypeVector: return "TypeVector"; break;
-    case saOp_TypeMatrix: return "TypeMatrix"; break;
-    case saOp_TypeImage: return "TypeImage"; break;
-    case saOp_TypeSampler: return "TypeSampler"; break;
-    case saOp_TypeSampledImage: return "TypeSampledImage"; break;
-    case saOp_TypeArray: return "TypeArray"; break;
-    case saOp_TypeRuntimeArray: return "TypeRuntimeArray"; break;
-    case saOp_TypeStruct: return "TypeStruct"; break;
-    case saOp_TypeOpaque: return "TypeOpaque"; break;
-    case saOp_TypePointer: return "TypePointer"; break;
-    case saOp_TypeFunction: return "TypeFunction"; break;
-    case saOp_TypeEvent: return "TypeEvent"; break;
-    case saOp_TypeDeviceEvent: return "TypeDeviceEvent"; break;
-    case saOp_TypeReserveId: return "TypeReserveId"; break;
-    case saOp_TypeQueue: return "TypeQueue"; break;
-    case saOp_TypePipe: return "TypePipe"; break;
-    case saOp_TypeForwardPointer: return "TypeForwardPointer"; break;
-    case saOp_ConstantTrue: return "ConstantTrue"; break;
-    case saOp_ConstantFalse: return "ConstantFalse"; break;
-    case saOp_Constant: return "Constant"; break;
-    case saOp_ConstantComposite: return "ConstantComposite"; break;
-    case saOp_ConstantSampler: return "ConstantSampler"; break;
-    case saOp_ConstantNull: return "ConstantNull"; break;
-    case saOp_SpecConstantTrue: return "SpecConstantTrue"; break;
-    case saOp_SpecConstantFalse: return "SpecConstantFalse"; break;
-    case saOp_SpecConstant: return "SpecConstant"; break;
-    case saOp_SpecConstantComposite: return "SpecConstantComposite"; break;
-    case saOp_SpecConstantOp: return "SpecConstantOp"; break;
-    case saOp_Function: return "Function"; break;
-    case saOp_FunctionParameter: return "FunctionParameter"; break;
-    case saOp_FunctionEnd: return "FunctionEnd"; break;
-    case saOp_FunctionCall: return "FunctionCall"; break;
-    case saOp_Variable: return "Variable"; break;
-    case saOp_ImageTexelPointer: return "ImageTexelPointer"; break;
-    case saOp_Load: return "Load"; break;
-    case saOp_Store: return "Store"; break;
-    case saOp_CopyMemory: return "CopyMemory"; break;
-    case saOp_CopyMemorySized: return "CopyMemorySized"; break;
-    case saOp_AccessChain: return "AccessChain"; break;
-    case saOp_InBoundsAccessChain: return "InBoundsAccessChain"; break;
-    case saOp_PtrAccessChain: return "PtrAccessChain"; break;
-    case saOp_ArrayLength: return "ArrayLength"; break;
-    case saOp_GenericPtrMemSemantics: return "GenericPtrMemSemantics"; break;
-    case saOp_InBoundsPtrAccessChain: return "InBoundsPtrAccessChain"; break;
-    case saOp_Decorate: return "Decorate"; break;
-    case saOp_MemberDecorate: return "MemberDecorate"; break;
-    case saOp_DecorationGroup: return "DecorationGroup"; break;
-    case saOp_GroupDecorate: return "GroupDecorate"; break;
-    case saOp_GroupMemberDecorate: return "GroupMemberDecorate"; break;
-    case saOp_VectorExtractDynamic: return "VectorExtractDynamic"; break;
-    case saOp_VectorInsertDynamic: return "VectorInsertDynamic"; break;
-    case saOp_VectorShuffle: return "VectorShuffle"; break;
-    case saOp_CompositeConstruct: return "CompositeConstruct"; break;
-    case saOp_CompositeExtract: return "CompositeExtract"; break;
-    case saOp_CompositeInsert: return "CompositeInsert"; break;
-    case saOp_CopyObject: return "CopyObject"; break;
-    case saOp_Transpose: return "Transpose"; break;
-    case saOp_SampledImage: return "SampledImage"; break;
-    case saOp_ImageSampleImplicitLod: return "ImageSampleImplicitLod"; break;
-    case saOp_ImageSampleExplicitLod: return "ImageSampleExplicitLod"; break;
-    case saOp_ImageSampleDrefImplicitLod: return "ImageSampleDrefImplicitLod"; break;
-    case saOp_ImageSampleDrefExplicitLod: return "ImageSampleDrefExplicitLod"; break;
-    case saOp_ImageSampleProjImplicitLod: return "ImageSampleProjImplicitLod"; break;
-    case saOp_ImageSampleProjExplicitLod: return "ImageSampleProjExplicitLod"; break;
-    case saOp_ImageSampleProjDrefImplicitLod: return "ImageSampleProjDrefImplicitLod"; break;
-    case saOp_ImageSampleProjDrefExplicitLod: return "ImageSampleProjDrefExplicitLod"; break;
-    case saOp_ImageFetch: return "ImageFetch"; break;
-    case saOp_ImageGather: return "ImageGather"; break;
-    case saOp_ImageDrefGather: return "ImageDrefGather"; break;
-    case saOp_ImageRead: return "ImageRead"; break;
-    case saOp_ImageWrite: return "ImageWrite"; break;
-    case saOp_Image: return "Image"; break;
-    case saOp_ImageQueryFormat: return "ImageQueryFormat"; break;
-    case saOp_ImageQueryOrder: return "ImageQueryOrder"; break;
-    case saOp_ImageQuerySizeLod: return "ImageQuerySizeLod"; break;
-    case saOp_ImageQuerySize: return "ImageQuerySize"; break;
-    case saOp_ImageQueryLod: return "ImageQueryLod"; break;
-    case saOp_ImageQueryLevels: return "ImageQueryLevels"; break;
-    case saOp_ImageQuerySamples: return "ImageQuerySamples"; break;
-    case saOp_ConvertFToU: return "ConvertFToU"; break;
-    case saOp_ConvertFToS: return "ConvertFToS"; break;
-    case saOp_ConvertSToF: return "ConvertSToF"; break;
-    case saOp_ConvertUToF: return "ConvertUToF"; break;
-    case saOp_UConvert: return "UConvert"; break;
-    case saOp_SConvert: return "SConvert"; break;
-    case saOp_FConvert: return "FConvert"; break;
-    case saOp_QuantizeToF16: return "QuantizeToF16"; break;
-    case saOp_ConvertPtrToU: return "ConvertPtrToU"; break;
-    case saOp_SatConvertSToU: return "SatConvertSToU"; break;
-    case saOp_SatConvertUToS: return "SatConvertUToS"; break;
-    case saOp_ConvertUToPtr: return "ConvertUToPtr"; break;
-    case saOp_PtrCastToGeneric: return "PtrCastToGeneric"; break;
-    case saOp_GenericCastToPtr: return "GenericCastToPtr"; break;
-    case saOp_GenericCastToPtrExplicit: return "GenericCastToPtrExplicit"; break;
-    case saOp_Bitcast: return "Bitcast"; break;
-    case saOp_SNegate: return "SNegate"; break;
-    case saOp_FNegate: return "FNegate"; break;
-    case saOp_IAdd: return "IAdd"; break;
-    case saOp_FAdd: return "FAdd"; break;
-    case saOp_ISub: return "ISub"; break;
-    case saOp_FSub: return "FSub"; break;
-    case saOp_IMul: return "IMul"; break;
-    case saOp_FMul: return "FMul"; break;
-    case saOp_UDiv: return "UDiv"; break;
-    case saOp_SDiv: return "SDiv"; break;
-    case saOp_FDiv: return "FDiv"; break;
-    case saOp_UMul: return "UMul"; break;
-    case saOp_SRem: return "SRem"; break;
-    case saOp_SMod: return "SMod"; break;
-    case saOp_FRem: return "FRem"; break;
-    case saOp_FMod: return "FMod"; break;
-    case saOp_VectorTimesScalar: return "VectorTimesScalar"; break;
-    case saOp_MatrixTimesScalar: return "MatrixTimesScalar"; break;
-    case saOp_VectorTimesMatrix: return "VectorTimesMatrix"; break;
-    case saOp_MatrixTimesVector: return "MatrixTimesVector"; break;
-    case saOp_MatrixTimesMatrix: return "MatrixTimesMatrix"; break;
-    case saOp_OuterProduct: return "OuterProduct"; break;
-    case saOp_Dot: return "Dot"; break;
-    case saOp_IAddCarry: return "IAddCarry"; break;
-    case saOp_ISubBorrow: return "ISubBorrow"; break;
-    case saOp_UMulExtended: return "UMulExtended"; break;
-    case saOp_SMulExtended: return "SMulExtended"; break;
-    case saOp_Any: return "Any"; break;
-    case saOp_All: return "All"; break;
-    case saOp_IsNan: return "IsNan"; break;
-    case saOp_IsInf: return "IsInf"; break;
-    case saOp_IsFinite: return "IsFinite"; break;
-    case saOp_IsNormal: return "IsNormal"; break;
-    case saOp_SignBitSet: return "SignBitSet"; break;
-    case saOp_LessOrGreater: return "LessOrGreater"; break;
-    case saOp_Ordered: return "Ordered"; break;
-    case saOp_Unordered: return "Unordered"; break;
-    case saOp_LogicalEqual: return "LogicalEqual"; break;
-    case saOp_LogicalNotEqual: return "LogicalNotEqual"; break;
-    case saOp_LogicalOr: return "LogicalOr"; break;
-    case saOp_LogicalAnd: return "LogicalAnd"; break;
-    case saOp_LogicalNot: return "LogicalNot"; break;
-    case saOp_Select: return "Select"; break;
-    case saOp_IEqual: return "IEqual"; break;
-    case saOp_INotEqual: return "INotEqual"; break;
-    case saOp_UGreaterThan: return "UGreaterThan"; break;
-    case saOp_SGreaterThan: return "SGreaterThan"; break;
-    case saOp_UGreaterThanEqual: return "UGreaterThanEqual"; break;
-    case saOp_SGreaterThanEqual: return "SGreaterThanEqual"; break;
-    case saOp_ULessThan: return "ULessThan"; break;
-    case saOp_SLessThan: return "SLessThan"; break;
-    case saOp_ULessThanEqual: return "ULessThanEqual"; break;
-    case saOp_SLessThanEqual: return "SLessThanEqual"; break;
-    case saOp_FOrdEqual: return "FOrdEqual"; break;
-    case saOp_FUnordEqual: return "FUnordEqual"; break;
-    case saOp_FOrdNotEqual: return "FOrdNotEqual"; break;
-    case saOp_FUnordNotEqual: return "FUnordNotEqual"; break;
-    case saOp_FOrdLessThan: return "FOrdLessThan"; break;
-    case saOp_FUnordLessThan: return "FUnordLessThan"; break;
-    case saOp_FOrdGreaterThan: return "FOrdGreaterThan"; break;
-    case saOp_FUnordGreaterThan: return "FUnordGreaterThan"; break;
-    case saOp_FOrdLessThanEqual: return "FOrdLessThanEqual"; break;
-    case saOp_FUnordLessThanEqual: return "FUnordLessThanEqual"; break;
-    case saOp_FOrdGreaterThanEqual: return "FOrdGreaterThanEqual"; break;
-    case saOp_FUnordGreaterThanEqual: return "FUnordGreaterThanEqual"; break;
-    case saOp_ShiftRightLogical: return "ShiftRightLogical"; break;
-    case saOp_ShiftRightArithmetic: return "ShiftRightArithmetic"; break;
-    case saOp_ShiftLeftLogical: return "ShiftLeftLogical"; break;
-    case saOp_BitwiseOr: return "BitwiseOr"; break;
-    case saOp_BitwiseXor: return "BitwiseXor"; break;
-    case saOp_BitwiseAnd: return "BitwiseAnd"; break;
-    case saOp_Not: return "Not"; break;
-    case saOp_BitFieldInsert: return "BitFieldInsert"; break;
-    case saOp_BitFieldSExtract: return "BitFieldSExtract"; break;
-    case saOp_BitFieldUExtract: return "BitFieldUExtract"; break;
-    case saOp_BitReverse: return "BitReverse"; break;
-    case saOp_BitCount: return "BitCount"; break;
-    case saOp_DPdx: return "DPdx"; break;
-    case saOp_DPdy: return "DPdy"; break;
-    case saOp_Fwidth: return "Fwidth"; break;
-    case saOp_DPdxFine: return "DPdxFine"; break;
-    case saOp_DPdyFine: return "DPdyFine"; break;
-    case saOp_FwidthFine: return "FwidthFine"; break;
-    case saOp_DPdxCoarse: return "DPdxCoarse"; break;
-    case saOp_DPdyCoarse: return "DPdyCoarse"; break;
-    case saOp_FwidthCoarse: return "FwidthCoarse"; break;
-    case saOp_EmitVertex: return "EmitVertex"; break;
-    case saOp_EndPrimitive: return "EndPrimitive"; break;
-    case saOp_EmitStreamVertex: return "EmitStreamVertex"; break;
-    case saOp_EndStreamPrimitive: return "EndStreamPrimitive"; break;
-    case saOp_ControlBarrier: return "ControlBarrier"; break;
-    case saOp_MemoryBarrier: return "MemoryBarrier"; break;
-    case saOp_AtomicLoad: return "AtomicLoad"; break;
-    case saOp_AtomicStore: return "AtomicStore"; break;
-    case saOp_AtomicExchange: return "AtomicExchange"; break;
-    case saOp_AtomicCompareExchange: return "AtomicCompareExchange"; break;
-    case saOp_AtomicCompareExchangeWeak: return "AtomicCompareExchangeWeak"; break;
-    case saOp_AtomicIIncrement: return "AtomicIIncrement"; break;
-    case saOp_AtomicIDecrement: return "AtomicIDecrement"; break;
-    case saOp_AtomicIAdd: return "AtomicIAdd"; break;
-    case saOp_AtomicISub: return "AtomicISub"; break;
-    case saOp_AtomicSMin: return "AtomicSMin"; break;
-    case saOp_AtomicUMin: return "AtomicUMin"; break;
-    case saOp_AtomicSMax: return "AtomicSMax"; break;
-    case saOp_AtomicUMax: return "AtomicUMax"; break;
-    case saOp_AtomicAnd: return "AtomicAnd"; break;
-    case saOp_AtomicOr: return "AtomicOr"; break;
-    case saOp_AtomicXor: return "AtomicXor"; break;
-    case saOp_Phi: return "Phi"; break;
-    case saOp_LoopMerge: return "LoopMerge"; break;
-    case saOp_SelectionMerge: return "SelectionMerge"; break;
-    case saOp_Label: return "Label"; break;
-    case saOp_Branch: return "Branch"; break;
-    case saOp_BranchConditional: return "BranchConditional"; break;
-    case saOp_Switch: return "Switch"; break;
-    case saOp_Kill: return "Kill"; break;
-    case saOp_Return: return "Return"; break;
-    case saOp_ReturnValue: return "ReturnValue"; break;
-    case saOp_Unreachable: return "Unreachable"; break;
-    case saOp_LifetimeStart: return "LifetimeStart"; break;
-    case saOp_LifetimeStop: return "LifetimeStop"; break;
-    case saOp_GroupAsyncCopy: return "GroupAsyncCopy"; break;
-    case saOp_GroupWaitEvents: return "GroupWaitEvents"; break;
-    case saOp_GroupAll: return "GroupAll"; break;
-    case saOp_GroupAny: return "GroupAny"; break;
-    case saOp_GroupBroadcast: return "GroupBroadcast"; break;
-    case saOp_GroupIAdd: return "GroupIAdd"; break;
-    case saOp_GroupFAdd: return "GroupFAdd"; break;
-    case saOp_GroupFMin: return "GroupFMin"; break;
-    case saOp_GroupUMin: return "GroupUMin"; break;
-    case saOp_GroupSMin: return "GroupSMin"; break;
-    case saOp_GroupFMax: return "GroupFMax"; break;
-    case saOp_GroupUMax: return "GroupUMax"; break;
-    case saOp_GroupSMax: return "GroupSMax"; break;
-    case saOp_ReadPipe: return "ReadPipe"; break;
-    case saOp_WritePipe: return "WritePipe"; break;
-    case saOp_ReservedReadPipe: return "ReservedReadPipe"; break;
-    case saOp_ReservedWritePipe: return "ReservedWritePipe"; break;
-    case saOp_ReservedReadPipePackets: return "ReservedReadPipePackets"; break;
-    case saOp_ReservedWritePipePackets: return "ReservedWritePipePackets"; break;
-    case saOp_CommitReadPipe: return "CommitReadPipe"; break;
-    case saOp_CommitWritePipe: return "CommitWritePipe"; break;
-    case saOp_IsValidReservedId: return "IsValidReservedId"; break;
-    case saOp_GetNumPipePackets: return "GetNumPipePackets"; break;
-    case saOp_GetMaxPipePackets: return "GetMaxPipePackets"; break;
-    case saOp_GroupReserveReadPipePackets: return "GroupReserveReadPipePackets"; break;
-    case saOp_GroupReserveWritePipePackets: return "GroupReserveWritePipePackets"; break;
-    case saOp_GroupCommitReadPipe: return "GroupCommitReadPipe"; break;
-    case saOp_GroupCommitWritePipe: return "GroupCommitWritePipe"; break;
-    case saOp_EnqueueMarker: return "EnqueueMarker"; break;
-    case saOp_EnqueueKernel: return "EnqueueKernel"; break;
-    case saOp_GetKernelINDrangeSubGroupCount: return "GetKernelINDrangeSubGroupCount"; break;
-    case saOp_GetKernelINDrangeMaxSubGroupSize: return "GetKernelINDrangeMaxSubGroupSize"; break;
-    case saOp_GetKernelIWorkGroupSize: return "GetKernelIWorkGroupSize"; break;
-    case saOp_GetKernelIPreferredWorkGroupSizeMultiple: return "GetKernelIPreferredWorkGroupSizeMultiple"; break;
-    case saOp_RetainEvent: return "RetainEvent"; break;
-    case saOp_ReleaseEvent: return "ReleaseEvent"; break;
-    case saOp_CreateUserEvent: return "CreateUserEvent"; break;
-    case saOp_IsValidEvent: return "IsValidEvent"; break;
-    case saOp_SetUserEventStatus: return "SetUserEventStatus"; break;
-    case saOp_CaptureEventProfilingInfo: return "CaptureEventProfilingInfo"; break;
-    case saOp_GetDefaultQueue: return "GetDefaultQueue"; break;
-    case saOp_BuildNDRange: return "BuildNDRange"; break;
-    case saOp_ImageSparseSampleImplicitLod: return "ImageSparseSampleImplicitLod"; break;
-    case saOp_ImageSparseSampleExplicitLod: return "ImageSparseSampleExplicitLod"; break;
-    case saOp_ImageSparseSampleDrefImplicitLod: return "ImageSparseSampleDrefImplicitLod"; break;
-    case saOp_ImageSparseSampleDrefExplicitLod: return "ImageSparseSampleDrefExplicitLod"; break;
-    case saOp_ImageSparseFetch: return "ImageSparseFetch"; break;
-    case saOp_ImageSparseGather: return "ImageSparseGather"; break;
-    case saOp_ImageSparseDrefGather: return "ImageSparseDrefGather"; break;
-    case saOp_ImageSparseTexelResident: return "ImageSparseTexelResident"; break;
-    case saOp_NoLine: return "NoLine"; break;
-    case saOp_AtomicFlagTestAndSet: return "AtomicFlagTestAndSet"; break;
-    case saOp_AtomicFlagClear: return "AtomicFlagClear"; break;
-    case saOp_ImageSparseRead: return "ImageSparseRead"; break;
-    case saOp_SizeOf: return "SizeOf"; break;
-    case saOp_TypePipeStorage: return "TypePipeStorage"; break;
-    case saOp_ConstantPipeStorage: return "ConstantPipeStorage"; break;
-    case saOp_CreatePipeFromPipeStorage: return "CreatePipeFromPipeStorage"; break;
-    case saOp_GetKernelLocalSizeForSubgroupCount: return "GetKernelLocalSizeForSubgroupCount"; break;
-    case saOp_GetKernelMaxNumSubgroups: return "GetKernelMaxNumSubgroups"; break;
-    case saOp_TypeNamedBarrier: return "TypeNamedBarrier"; break;
-    case saOp_NamedBarrierInitialize: return "NamedBarrierInitialize"; break;
-    case saOp_MemoryNamedBarrier: return "MemoryNamedBarrier"; break;
-    case saOp_ModuleProcessed: return "ModuleProcessed"; break;
-    case saOp_ExecutionModeId: return "ExecutionModeId"; break;
-    case saOp_DecorateId: return "DecorateId"; break;
-    case saOp_GroupNonUniformElect: return "GroupNonUniformElect"; break;
-    case saOp_GroupNonUniformAll: return "GroupNonUniformAll"; break;
-    case saOp_GroupNonUniformAny: return "GroupNonUniformAny"; break;
-    case saOp_GroupNonUniformAllEqual: return "GroupNonUniformAllEqual"; break;
-    case saOp_GroupNonUniformBroadcast: return "GroupNonUniformBroadcast"; break;
-    case saOp_GroupNonUniformBroadcastFirst: return "GroupNonUniformBroadcastFirst"; break;
-    case saOp_GroupNonUniformBallot: return "GroupNonUniformBallot"; break;
-    case saOp_GroupNonUniformInverseBallot: return "GroupNonUniformInverseBallot"; break;
-    case saOp_GroupNonUniformBallotBitExtract: return "GroupNonUniformBallotBitExtract"; break;
-    case saOp_GroupNonUniformBallotBitCount: return "GroupNonUniformBallotBitCount"; break;
-    case saOp_GroupNonUniformBallotFindLSB: return "GroupNonUniformBallotFindLSB"; break;
-    case saOp_GroupNonUniformBallotFindMSB: return "GroupNonUniformBallotFindMSB"; break;
-    case saOp_GroupNonUniformShuffle: return "GroupNonUniformShuffle"; break;
-    case saOp_GroupNonUniformShuffleXor: return "GroupNonUniformShuffleXor"; break;
-    case saOp_GroupNonUniformShuffleUp: return "GroupNonUniformShuffleUp"; break;
-    case saOp_GroupNonUniformShuffleDown: return "GroupNonUniformShuffleDown"; break;
-    case saOp_GroupNonUniformIAdd: return "GroupNonUniformIAdd"; break;
-    case saOp_GroupNonUniformFAdd: return "GroupNonUniformFAdd"; break;
-    case saOp_GroupNonUniformIMul: return "GroupNonUniformIMul"; break;
-    case saOp_GroupNonUniformFMul: return "GroupNonUniformFMul"; break;
-    case saOp_GroupNonUniformSMin: return "GroupNonUniformSMin"; break;
-    case saOp_GroupNonUniformUMin: return "GroupNonUniformUMin"; break;
-    case saOp_GroupNonUniformFMin: return "GroupNonUniformFMin"; break;
-    case saOp_GroupNonUniformSMax: return "GroupNonUniformSMax"; break;
-    case saOp_GroupNonUniformUMax: return "GroupNonUniformUMax"; break;
-    case saOp_GroupNonUniformFMax: return "GroupNonUniformFMax"; break;
-    case saOp_GroupNonUniformBitwiseAnd: return "GroupNonUniformBitwiseAnd"; break;
-    case saOp_GroupNonUniformBitwiseOr: return "GroupNonUniformBitwiseOr"; break;
-    case saOp_GroupNonUniformBitwiseXor: return "GroupNonUniformBitwiseXor"; break;
-    case saOp_GroupNonUniformLogicalAnd: return "GroupNonUniformLogicalAnd"; break;
-    case saOp_GroupNonUniformLogicalOr: return "GroupNonUniformLogicalOr"; break;
-    case saOp_GroupNonUniformLogicalXor: return "GroupNonUniformLogicalXor"; break;
-    case saOp_GroupNonUniformQuadBroadcast: return "GroupNonUniformQuadBroadcast"; break;
-    case saOp_GroupNonUniformQuadSwap: return "GroupNonUniformQuadSwap"; break;
-    case saOp_CopyLogical: return "CopyLogical"; break;
-    case saOp_PtrEqual: return "PtrEqual"; break;
-    case saOp_PtrNotEqual: return "PtrNotEqual"; break;
-    case saOp_PtrDiff: return "PtrDiff"; break;  
-  }
+  if(opcode >= SA_OPCODE_COUNT || !SA_ASSEMBLER_OPCODE_INFO[opcode].mnemonic)
+    return "";
 
-  return "";
+  return SA_ASSEMBLER_OPCODE_INFO[opcode].mnemonic;
 }
 
 static const char* sa__sectionToString(sa_uint32_t section) {
@@ -2687,6 +3236,84 @@ static void* sa__copyMemory(const void* pSrc, void* pDst, sa_uint32_t size) {
   return pDst;
 }
 
+/**
+ * @brief Copies 32 bit words, meant for SPIR-V streams where size is always in words
+ * 
+ * @param pSrc 
+ * @param pDst 
+ * @param count amount of words
+ * @return sa_uint32_t* 
+ */
+static sa_uint32_t* sa__copyWords(const sa_uint32_t* pSrc, sa_uint32_t* pDst, sa_uint32_t count) {
+  sa_uint32_t i = 0;
+
+  // Unrolled so compiler can turn it into wide loads and stores
+  for(; i + 4 <= count; i += 4) {
+    pDst[i + 0] = pSrc[i + 0];
+    pDst[i + 1] = pSrc[i + 1];
+    pDst[i + 2] = pSrc[i + 2];
+    pDst[i + 3] = pSrc[i + 3];
+  }
+
+  for(; i < count; i++)
+    pDst[i] = pSrc[i];
+
+  return pDst;
+}
+
+/**
+ * @brief Copies words between ranges that can overlap
+ * 
+ * @param pSrc 
+ * @param pDst 
+ * @param count amount of words
+ * @return sa_uint32_t* 
+ */
+static sa_uint32_t* sa__moveWords(const sa_uint32_t* pSrc, sa_uint32_t* pDst, sa_uint32_t count) {
+  if(pDst == pSrc)
+    return pDst;
+
+  // Going forward only overwrites words that were already read when destination is lower
+  if(pDst < pSrc)
+    return sa__copyWords(pSrc, pDst, count);
+
+  sa_uint32_t i = count;
+
+  // Unrolled the same way as sa__copyWords, every word is read before anything overwrites it
+  for(; i >= 4; i -= 4) {
+    pDst[i - 1] = pSrc[i - 1];
+    pDst[i - 2] = pSrc[i - 2];
+    pDst[i - 3] = pSrc[i - 3];
+    pDst[i - 4] = pSrc[i - 4];
+  }
+
+  for(; i > 0; i--)
+    pDst[i - 1] = pSrc[i - 1];
+
+  return pDst;
+}
+
+/**
+ * @brief Copies bytes between ranges that can overlap
+ * 
+ * @param pSrc 
+ * @param pDst 
+ * @param size 
+ * @return void* 
+ */
+static void* sa__moveMemory(const void* pSrc, void* pDst, sa_uint32_t size) {
+  if(sa_ptr8(pDst) == sa_ptr8(pSrc))
+    return pDst;
+
+  if(sa_ptr8(pDst) < sa_ptr8(pSrc))
+    return sa__copyMemory(pSrc, pDst, size);
+
+  for(sa_uint32_t i = size; i > 0; i--)
+    sa_ptr8(pDst)[i - 1] = sa_ptr8(pSrc)[i - 1];
+
+  return pDst;
+}
+
 static void* sa__setMemory(void* pMem, int value, sa_uint32_t size) {
   for(sa_uint32_t i = 0; i < size; i++) {
     sa_ptr8(pMem)[i] = value;
@@ -2708,6 +3335,31 @@ static sa_uint32_t sa__compareString(const char* a, const char* b) {
   return a[index] - b[index];
 }
 
+/**
+ * @brief Compares null terminated string with string of known length
+ * 
+ * @param a null terminated string
+ * @param b string that does not need to be null terminated
+ * @param bLength length of b
+ * @return int lower than 0 when a goes before b, 0 when equal, greater than 0 otherwise
+ */
+static int sa__compareStringLength(const char* a, const char* b, sa_uint32_t bLength) {
+  sa_uint32_t index = 0;
+
+  while(a[index] && index < bLength) {
+    if(a[index] != b[index])
+      return (int)(sa_uint8_t)a[index] - (int)(sa_uint8_t)b[index];
+
+    index++;
+  }
+
+  // a ended first (or both ended) or b ended first
+  if(index < bLength)
+    return -1;
+
+  return a[index] ? 1 : 0;
+}
+
 static sa_uint32_t sa__lengthString(const char* str) {
   sa_uint32_t len = 0;
   
@@ -2721,1058 +3373,4879 @@ static sa_bool sa__isCharDigit(sa_uint8_t c) {
   return c >= '0' && c <= '9';
 }
 
-static sa_bool sa__isStringInteger(const char* str) {
-  for(sa_uint32_t i = 0; i < sa__lengthString(str); i++) {
-    if(!sa__isCharDigit(str[i]))
-      return SA_FALSE;
-  }
-  
-  return SA_TRUE;
-}
-
-static sa_bool sa__isStringFloat(const char* str) {
-  for(sa_uint32_t i = 0; i < sa__lengthString(str); i++) {
-    if(!sa__isCharDigit(str[i]) && str[i] != '.')
-      return SA_FALSE;
-  }
-  
-  return SA_TRUE;
-}
-
-static sa_int32_t sa__stringToInt(const char* str) {
-  char* p = (char*)&str[0];
-  sa_int32_t result = 0;
+typedef enum sa__numberKind_e {
+  saNumberKind_None = 0,
+  saNumberKind_Integer,
+  saNumberKind_Float,
+} sa__numberKind_t;
 
-  if(*p == '-')
-    p++;
-
-  while(*p && sa__isCharDigit(*p)) {
-    result *= 10;
-    result += *p - '0';
-    p++;
-  }
+/**
+ * @brief Numeric literal classified in one pass, integer part is exact and float part is kept as decimal mantissa and exponent until it is known which width is needed
+ */
+typedef struct sa__number_s {
+  sa__numberKind_t kind;
+  sa_bool negative;
+  // Integer did not fit into 64 bits
+  sa_bool overflow;
+  // Magnitude of integer literal
+  sa_uint64_t integer;
+  // Value is mantissa * 10^exponent, up to 19 significant digits
+  sa_uint64_t mantissa;
+  sa_int32_t exponent;
+  // Some significant digits did not fit into mantissa, fast path cannot be used
+  sa_bool truncated;
+} sa__number_t;
+
+static sa_uint32_t sa__hexDigitValue(sa_uint8_t c) {
+  if(c >= '0' && c <= '9')
+    return c - '0';
+
+  // Lower case bit folds 'A'..'F' into 'a'..'f'
+  c |= 0x20;
+
+  if(c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
 
-  return str[0] == '-' ? -result : result;
+  return SA_UINT32_MAX;
 }
 
-static float sa__stringToFloat(const char* str) {
-  char* p = (char*)&str[0];
-  float left = 0.0f;
-  float right = 0.0f;
+/**
+ * @brief Classifies and parses decimal, hex (0x), signed and exponent form literals in a single pass
+ * 
+ * @param str does not need to be null terminated
+ * @param length 
+ * @param pNumber filled with parsed value
+ * @return sa_bool SA_FALSE if text is not a number
+ */
+static sa_bool sa__parseNumber(const char* str, sa_uint32_t length, sa__number_t* pNumber) {
+  sa__setMemory(pNumber, 0, sizeof(*pNumber));
 
-  if(*p == '-')
-    p++;
+  sa_uint32_t i = 0;
 
-  while(*p && sa__isCharDigit(*p)) {
-    left *= 10.0f;
-    left += (float)(*p - '0');
-    p++;
+  if(i < length && (str[i] == '-' || str[i] == '+')) {
+    pNumber->negative = str[i] == '-';
+    i++;
   }
 
-  if(*p == '.') {
-    while(*p && sa__isCharDigit(*p)) {
-      right += (float)(*p - '0');
-      right /= 10.0f;
-      p++;
-    }
-  }
+  if(i == length)
+    return SA_FALSE;
 
-  return str[0] == '-' ? -(left + right) : (left + right);
-}
+  if(str[i] == '0' && i + 1 < length && (str[i + 1] | 0x20) == 'x') {
+    i += 2;
+
+    if(i == length)
+      return SA_FALSE;
 
-static char* sa__intToString(sa_int32_t value) {
-  static char str[32] = {0};
+    for(; i < length; i++) {
+      const sa_uint32_t digit = sa__hexDigitValue(str[i]);
 
-  sa__setMemory(str, 0, 32 * sizeof(char));
+      if(digit == SA_UINT32_MAX)
+        return SA_FALSE;
 
-  sa_uint32_t num = value;
-  sa_uint32_t numCounter = 0;
+      if(pNumber->integer >> 60)
+        pNumber->overflow = SA_TRUE;
 
-  if(num < 0) {
-    numCounter++;
-    num = -num;
-  }
+      pNumber->integer = (pNumber->integer << 4) | digit;
+    }
 
-  while(num) {
-    str[numCounter] = '0' + (num % 10);
-    numCounter++;
-    num /= 10;
-  }
+    pNumber->kind = saNumberKind_Integer;
+    pNumber->mantissa = pNumber->integer;
+    pNumber->truncated = pNumber->overflow;
 
-  for(sa_uint32_t i = 0; i < numCounter / 2; i++) {
-    char tmp = str[i];
-    str[i] = str[(numCounter - 1) - i];
-    str[(numCounter - 1) - i] = tmp;
+    return SA_TRUE;
   }
 
-  if(value < 0)
-    str[0] = '-';
+  sa_uint32_t digits = 0;
+  sa_uint32_t significantDigits = 0;
+  sa_bool isFloat = SA_FALSE;
 
-  return str;
-}
+  for(; i < length && sa__isCharDigit(str[i]); i++) {
+    const sa_uint32_t digit = str[i] - '0';
 
-static char* sa__hexToString(sa_uint32_t value) {
-  static char str[32] = {0};
-  sa__setMemory(str, 0, 32 * sizeof(char));
+    // Limits are constants, so there is no division per digit
+    if(pNumber->integer > SA_UINT64_MAX / 10 || (pNumber->integer == SA_UINT64_MAX / 10 && digit > SA_UINT64_MAX % 10))
+      pNumber->overflow = SA_TRUE;
+    else
+      pNumber->integer = pNumber->integer * 10 + digit;
 
-  sa_uint32_t num = value;
-  sa_uint32_t numCounter = 0;
+    // Leading zeros are not significant
+    if(significantDigits < 19) {
+      pNumber->mantissa = pNumber->mantissa * 10 + digit;
+      significantDigits += pNumber->mantissa != 0;
+    }
+    else {
+      pNumber->exponent++;
+      pNumber->truncated |= digit != 0;
+    }
 
-  while(num) {
-    str[numCounter] = ((num & 0xF) < 0xA ? '0' + num : 'A' + (num - 0xA));
-    numCounter++;
-    num >>= 4;
+    digits++;
   }
 
-  for(sa_uint32_t i = 0; i < numCounter / 2; i++) {
-    char tmp = str[i];
-    str[i] = str[numCounter - i];
-    str[numCounter - i] = tmp;
-  }
+  if(i < length && str[i] == '.') {
+    isFloat = SA_TRUE;
+    i++;
 
-  return str;
-}
+    for(; i < length && sa__isCharDigit(str[i]); i++) {
+      const sa_uint32_t digit = str[i] - '0';
 
-static char* sa__floatToString(float value, int decimals) {
-  // buffer large enough for sign + int + dot + frac + null
-  static char buf[64] = {0};  
-  char* p = buf;
-  sa__setMemory(buf, 0, 32 * sizeof(char));
+      if(significantDigits < 19) {
+        pNumber->mantissa = pNumber->mantissa * 10 + digit;
+        pNumber->exponent--;
+        significantDigits += pNumber->mantissa != 0;
+      }
+      else {
+        pNumber->truncated |= digit != 0;
+      }
 
-  // handle sign
-  if (value < 0) {
-    *p++ = '-';
-    value = -value;
+      digits++;
+    }
   }
 
-  // integer part
-  int int_part = (int)value;
-  float frac_part = value - (float)int_part;
+  if(digits == 0)
+    return SA_FALSE;
 
-  // write integer digits (reverse first)
-  char intbuf[32] = {0};
-  char* ip = intbuf;
-  if (int_part == 0)
-    *ip++ = '0';
-  else {
-    while (int_part > 0) {
-      *ip++ = '0' + (int_part % 10);
-      int_part /= 10;
+  if(i < length && (str[i] | 0x20) == 'e') {
+    isFloat = SA_TRUE;
+    i++;
+
+    sa_bool negativeExponent = SA_FALSE;
+
+    if(i < length && (str[i] == '-' || str[i] == '+')) {
+      negativeExponent = str[i] == '-';
+      i++;
     }
-  }
 
-  // copy integer digits back in correct order
-  while (ip != intbuf)
-    *p++ = *--ip;
+    if(i == length)
+      return SA_FALSE;
 
-  // decimal point
-  if (decimals > 0) {
-    *p++ = '.';
+    sa_int32_t exponent = 0;
 
-    for (int i = 0; i < decimals; i++) {
-      frac_part *= 10.0f;
-      int digit = (int)frac_part;
-      *p++ = '0' + digit;
-      frac_part -= digit;
+    for(; i < length && sa__isCharDigit(str[i]); i++) {
+      // Anything this large is already infinity or zero
+      if(exponent < 100000)
+        exponent = exponent * 10 + (str[i] - '0');
     }
+
+    pNumber->exponent += negativeExponent ? -exponent : exponent;
   }
 
-  *p = '\0';
-  return buf;
+  if(i != length)
+    return SA_FALSE;
+
+  pNumber->kind = isFloat ? saNumberKind_Float : saNumberKind_Integer;
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Copies literal into null terminated buffer for strtod/strtof slow path
+ * 
+ * @param str 
+ * @param length 
+ * @param pBuffer 
+ * @param bufferSize 
+ * @return sa_bool SA_FALSE if literal does not fit
+ */
+static sa_bool sa__copyNumberText(const char* str, sa_uint32_t length, char* pBuffer, sa_uint32_t bufferSize) {
+  if(length >= bufferSize)
+    return SA_FALSE;
+
+  sa__copyMemory(str, pBuffer, length);
+  pBuffer[length] = 0;
+
+  return SA_TRUE;
+}
+
+static const double SA_EXACT_POWERS_OF_TEN[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+  1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+ * @brief Clinger fast path, mantissa and power of ten that are both exact in double need only one rounding
+ * 
+ * @param pNumber 
+ * @param pValue correctly rounded magnitude of the literal
+ * @return sa_bool SA_FALSE if slow path is needed
+ */
+static sa_bool sa__numberToDoubleFast(const sa__number_t* pNumber, double* pValue) {
+  if(pNumber->truncated || pNumber->mantissa > (1ULL << 53) || pNumber->exponent < -22 || pNumber->exponent > 22 || FLT_EVAL_METHOD != 0)
+    return SA_FALSE;
+
+  if(pNumber->exponent < 0)
+    *pValue = (double)pNumber->mantissa / SA_EXACT_POWERS_OF_TEN[-pNumber->exponent];
+  else
+    *pValue = (double)pNumber->mantissa * SA_EXACT_POWERS_OF_TEN[pNumber->exponent];
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Converts parsed literal to correctly rounded double, strtod is only used for what fast path cannot do
+ * 
+ * @param str text of the literal, used by slow path
+ * @param length 
+ * @param pNumber 
+ * @return double 
+ */
+static double sa__numberToDouble(const char* str, sa_uint32_t length, const sa__number_t* pNumber) {
+  double value;
+
+  if(!sa__numberToDoubleFast(pNumber, &value)) {
+    char buffer[512];
+
+    if(!sa__copyNumberText(str, length, buffer, sizeof(buffer)))
+      return 0.0;
+
+    // Sign is applied below
+    value = strtod(buffer + (buffer[0] == '-' || buffer[0] == '+'), SA_NULL);
+  }
+
+  return pNumber->negative ? -value : value;
+}
+
+/**
+ * @brief Converts parsed literal to correctly rounded float. Rounding correctly rounded double to float is exact unless that double lies right between two floats, only then strtof is needed
+ * 
+ * @param str text of the literal, used by slow path
+ * @param length 
+ * @param pNumber 
+ * @return float 
+ */
+static float sa__numberToFloat(const char* str, sa_uint32_t length, const sa__number_t* pNumber) {
+  double fast;
+  float value;
+
+  sa_uint64_t bits = 0;
+
+  if(sa__numberToDoubleFast(pNumber, &fast))
+    sa__copyMemory(&fast, &bits, sizeof(bits));
+
+  // Float has 29 mantissa bits less than double, midpoint has only the highest of them set. Subnormals have other spacing
+  if(bits && fast >= FLT_MIN && fast <= FLT_MAX && (bits & 0x1FFFFFFFULL) != 0x10000000ULL) {
+    value = (float)fast;
+  }
+  else if(pNumber->mantissa == 0) {
+    value = 0.0f;
+  }
+  else {
+    char buffer[512];
+
+    if(!sa__copyNumberText(str, length, buffer, sizeof(buffer)))
+      return 0.0f;
+
+    value = strtof(buffer + (buffer[0] == '-' || buffer[0] == '+'), SA_NULL);
+  }
+
+  return pNumber->negative ? -value : value;
+}
+
+static sa_int32_t sa__stringToInt(const char* str, sa_uint32_t length) {
+  sa__number_t number;
+
+  if(!sa__parseNumber(str, length, &number) || number.kind != saNumberKind_Integer)
+    return 0;
+
+  return (sa_int32_t)(number.negative ? 0U - (sa_uint32_t)number.integer : (sa_uint32_t)number.integer);
+}
+
+static float sa__stringToFloat(const char* str, sa_uint32_t length) {
+  sa__number_t number;
+
+  if(!sa__parseNumber(str, length, &number))
+    return 0.0f;
+
+  return sa__numberToFloat(str, length, &number);
+}
+
+/**
+ * @brief Writes unsigned decimal number, buffer needs at least 10 characters
+ * 
+ * @param value 
+ * @param pBuffer 
+ * @return sa_uint32_t length of number, buffer is not null terminated
+ */
+static sa_uint32_t sa__uintToString(sa_uint32_t value, char* pBuffer) {
+  sa_uint32_t length = 0;
+
+  do {
+    pBuffer[length++] = '0' + (value % 10);
+    value /= 10;
+  } while(value);
+
+  for(sa_uint32_t i = 0; i < length / 2; i++) {
+    char tmp = pBuffer[i];
+    pBuffer[i] = pBuffer[length - 1 - i];
+    pBuffer[length - 1 - i] = tmp;
+  }
+
+  return length;
+}
+
+/**
+ * @brief Writes decimal number, buffer needs at least 12 characters
+ * 
+ * @param value 
+ * @param pBuffer 
+ * @return sa_uint32_t length of number, buffer is not null terminated
+ */
+static sa_uint32_t sa__intToString(sa_int32_t value, char* pBuffer) {
+  if(value >= 0)
+    return sa__uintToString((sa_uint32_t)value, pBuffer);
+
+  // Unsigned so the lowest value can be negated too
+  pBuffer[0] = '-';
+
+  return 1 + sa__uintToString(0u - (sa_uint32_t)value, pBuffer + 1);
+}
+
+/**
+ * @brief Writes hexadecimal number without prefix, buffer needs at least 8 characters
+ * 
+ * @param value 
+ * @param pBuffer 
+ * @return sa_uint32_t length of number, buffer is not null terminated
+ */
+static sa_uint32_t sa__hexToString(sa_uint32_t value, char* pBuffer) {
+  sa_uint32_t length = 0;
+
+  do {
+    const sa_uint32_t digit = value & 0xF;
+
+    pBuffer[length++] = digit < 0xA ? '0' + digit : 'A' + (digit - 0xA);
+    value >>= 4;
+  } while(value);
+
+  for(sa_uint32_t i = 0; i < length / 2; i++) {
+    char tmp = pBuffer[i];
+    pBuffer[i] = pBuffer[length - 1 - i];
+    pBuffer[length - 1 - i] = tmp;
+  }
+
+  return length;
+}
+
+/**
+ * @brief Writes number with given amount of decimals, buffer needs at least 13 + decimals characters
+ * 
+ * @param value 
+ * @param decimals 
+ * @param pBuffer 
+ * @return sa_uint32_t length of number, buffer is not null terminated
+ */
+static sa_uint32_t sa__floatToString(float value, int decimals, char* pBuffer) {
+  char* p = pBuffer;
+
+  // handle sign
+  if (value < 0) {
+    *p++ = '-';
+    value = -value;
+  }
+
+  // Values past int range (and NaN) are clamped, converting them to int is undefined
+  if(!(value < 2147483520.0f))
+    value = 2147483520.0f;
+
+  // integer part
+  int int_part = (int)value;
+  float frac_part = value - (float)int_part;
+
+  // write integer digits (reverse first)
+  char intbuf[32] = {0};
+  char* ip = intbuf;
+  if (int_part == 0)
+    *ip++ = '0';
+  else {
+    while (int_part > 0) {
+      *ip++ = '0' + (int_part % 10);
+      int_part /= 10;
+    }
+  }
+
+  // copy integer digits back in correct order
+  while (ip != intbuf)
+    *p++ = *--ip;
+
+  // decimal point
+  if (decimals > 0) {
+    *p++ = '.';
+
+    for (int i = 0; i < decimals; i++) {
+      frac_part *= 10.0f;
+      int digit = (int)frac_part;
+      *p++ = '0' + digit;
+      frac_part -= digit;
+    }
+  }
+
+  return p - pBuffer;
+}
+
+//
+// Text scanning
+//
+
+#define SA_CHAR_WHITE       0x01
+#define SA_CHAR_NEWLINE     0x02
+#define SA_CHAR_PUNCTUATOR  0x04
+#define SA_CHAR_OPERATOR    0x08
+#define SA_CHAR_HASH        0x10
+// Masks of classes are stored by bit index of their SA_CHAR_* flag
+#define SA_CHAR_CLASS_COUNT 5
+
+// Bytes checked one by one before SIMD compares are used
+#define SA_SCAN_PROBE_LENGTH 16
+
+// Characters of every class, SA_CHAR_CLASS and SIMD compares are both based on those
+#define SA_WHITE_CHARS      " \t\r"
+#define SA_PUNCTUATOR_CHARS "[]{}(),.:;"
+#define SA_OPERATOR_CHARS   "+-*/=%^&|!~"
+
+// Class of every byte, scalar path and tails of SIMD path use it
+// Written out by position (no designated initializers, so it builds as C++ too), 16 bytes per row
+#define SA__W SA_CHAR_WHITE
+#define SA__N SA_CHAR_NEWLINE
+#define SA__P SA_CHAR_PUNCTUATOR
+#define SA__O SA_CHAR_OPERATOR
+#define SA__H SA_CHAR_HASH
+
+const sa_uint8_t SA_CHAR_CLASS[256] = {
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     SA__W, SA__N, 0,     0,     SA__W, 0,     0,     // 0x00
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0x10
+  SA__W, SA__O, 0,     SA__H, 0,     SA__O, SA__O, 0,     SA__P, SA__P, SA__O, SA__O, SA__P, SA__O, SA__P, SA__O, // 0x20
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     SA__P, SA__P, 0,     SA__O, 0,     0,     // 0x30
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0x40
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     SA__P, 0,     SA__P, SA__O, 0,     // 0x50
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0x60
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     SA__P, SA__O, SA__P, SA__O, 0,     // 0x70
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0x80
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0x90
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0xA0
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0xB0
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0xC0
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0xD0
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0xE0
+  0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     // 0xF0
+};
+
+#undef SA__W
+#undef SA__N
+#undef SA__P
+#undef SA__O
+#undef SA__H
+
+static sa_uint32_t sa__countTrailingZeros(sa_uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(value);
+#else
+  sa_uint32_t count = 0;
+
+  while(!(value & 1)) {
+    value >>= 1;
+    count++;
+  }
+
+  return count;
+#endif
+}
+
+static sa_uint32_t sa__popCount(sa_uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(value);
+#else
+  sa_uint32_t count = 0;
+
+  while(value) {
+    value &= value - 1;
+    count++;
+  }
+
+  return count;
+#endif
+}
+
+#ifdef SA_SIMD_SSE2
+/**
+ * @brief Classifies 16 bytes, bit shift + i of pMasks[c] is set when p[i] is of class 1 << c
+ * 
+ * @param p 16 bytes have to be readable
+ * @param classes SA_CHAR_* flags, masks of other classes are left as they are
+ * @param pMasks SA_CHAR_CLASS_COUNT masks
+ * @param shift 0 or 16
+ */
+static void sa__classify16SSE2(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks, sa_uint32_t shift) {
+  const __m128i v = _mm_loadu_si128((const __m128i*)p);
+
+  if(classes & SA_CHAR_WHITE) {
+    __m128i m = _mm_setzero_si128();
+
+    for(const char* c = SA_WHITE_CHARS; *c; c++)
+      m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(*c)));
+
+    pMasks[0] |= (sa_uint32_t)_mm_movemask_epi8(m) << shift;
+  }
+
+  if(classes & SA_CHAR_NEWLINE)
+    pMasks[1] |= (sa_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))) << shift;
+
+  if(classes & SA_CHAR_PUNCTUATOR) {
+    __m128i m = _mm_setzero_si128();
+
+    for(const char* c = SA_PUNCTUATOR_CHARS; *c; c++)
+      m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(*c)));
+
+    pMasks[2] |= (sa_uint32_t)_mm_movemask_epi8(m) << shift;
+  }
+
+  if(classes & SA_CHAR_OPERATOR) {
+    __m128i m = _mm_setzero_si128();
+
+    for(const char* c = SA_OPERATOR_CHARS; *c; c++)
+      m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(*c)));
+
+    pMasks[3] |= (sa_uint32_t)_mm_movemask_epi8(m) << shift;
+  }
+
+  if(classes & SA_CHAR_HASH)
+    pMasks[4] |= (sa_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('#'))) << shift;
+}
+
+static void sa__classify32SSE2(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks) {
+  sa__setMemory(pMasks, 0, sizeof(sa_uint32_t) * SA_CHAR_CLASS_COUNT);
+
+  sa__classify16SSE2(p, classes, pMasks, 0);
+  sa__classify16SSE2(p + 16, classes, pMasks, 16);
+}
+#endif
+
+#ifdef SA_SIMD_AVX2
+/**
+ * @brief Same as sa__classify32SSE2 with one compare per character, only called when CPU supports AVX2
+ * 
+ * @param p 32 bytes have to be readable
+ * @param classes SA_CHAR_* flags
+ * @param pMasks SA_CHAR_CLASS_COUNT masks, masks of other classes are 0
+ */
+__attribute__((target("avx2"))) static void sa__classify32AVX2(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks) {
+  const __m256i v = _mm256_loadu_si256((const __m256i*)p);
+
+  sa__setMemory(pMasks, 0, sizeof(sa_uint32_t) * SA_CHAR_CLASS_COUNT);
+
+  if(classes & SA_CHAR_WHITE) {
+    __m256i m = _mm256_setzero_si256();
+
+    for(const char* c = SA_WHITE_CHARS; *c; c++)
+      m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(*c)));
+
+    pMasks[0] = (sa_uint32_t)_mm256_movemask_epi8(m);
+  }
+
+  if(classes & SA_CHAR_NEWLINE)
+    pMasks[1] = (sa_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+
+  if(classes & SA_CHAR_PUNCTUATOR) {
+    __m256i m = _mm256_setzero_si256();
+
+    for(const char* c = SA_PUNCTUATOR_CHARS; *c; c++)
+      m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(*c)));
+
+    pMasks[2] = (sa_uint32_t)_mm256_movemask_epi8(m);
+  }
+
+  if(classes & SA_CHAR_OPERATOR) {
+    __m256i m = _mm256_setzero_si256();
+
+    for(const char* c = SA_OPERATOR_CHARS; *c; c++)
+      m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(*c)));
+
+    pMasks[3] = (sa_uint32_t)_mm256_movemask_epi8(m);
+  }
+
+  if(classes & SA_CHAR_HASH)
+    pMasks[4] = (sa_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('#')));
+}
+#endif
+
+#ifndef SA_SIMD_SSE2
+static void sa__classify32Scalar(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks) {
+  sa__setMemory(pMasks, 0, sizeof(sa_uint32_t) * SA_CHAR_CLASS_COUNT);
+
+  for(sa_uint32_t i = 0; i < 32; i++) {
+    const sa_uint8_t charClass = SA_CHAR_CLASS[(sa_uint8_t)p[i]] & classes;
+
+    for(sa_uint32_t c = 0; c < SA_CHAR_CLASS_COUNT; c++) {
+      if(charClass & (1u << c))
+        pMasks[c] |= 1u << i;
+    }
+  }
+}
+#endif
+
+#ifdef SA_SIMD_AVX2
+typedef void (*sa__classifyFn_t)(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks);
+
+static void sa__classify32Resolve(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks);
+
+// Widest SIMD CPU has, checked once on first call. Every thread that races there stores the same value
+static sa__classifyFn_t sa__classify32Fn = sa__classify32Resolve;
+
+static void sa__classify32Resolve(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks) {
+  const sa__classifyFn_t classify = __builtin_cpu_supports("avx2") ? sa__classify32AVX2 : sa__classify32SSE2;
+
+  __atomic_store_n(&sa__classify32Fn, classify, __ATOMIC_RELAXED);
+
+  classify(p, classes, pMasks);
+}
+#endif
+
+/**
+ * @brief Classifies 32 bytes with widest SIMD CPU has, bit i of pMasks[c] is set when p[i] is of class 1 << c
+ * 
+ * @param p 32 bytes have to be readable
+ * @param classes SA_CHAR_* flags
+ * @param pMasks SA_CHAR_CLASS_COUNT masks, masks of other classes are 0
+ */
+static void sa__classify32(const char* p, sa_uint8_t classes, sa_uint32_t* pMasks) {
+#if defined(SA_SIMD_AVX2)
+  __atomic_load_n(&sa__classify32Fn, __ATOMIC_RELAXED)(p, classes, pMasks);
+#elif defined(SA_SIMD_SSE2)
+  sa__classify32SSE2(p, classes, pMasks);
+#else
+  sa__classify32Scalar(p, classes, pMasks);
+#endif
+}
+
+/**
+ * @brief Bitmask of 32 bytes, bit i is set when p[i] belongs to any of classes
+ * 
+ * @param p 32 bytes have to be readable
+ * @param classes SA_CHAR_* flags
+ * @return sa_uint32_t 
+ */
+static sa_uint32_t sa__classMask32(const char* p, sa_uint8_t classes) {
+  sa_uint32_t masks[SA_CHAR_CLASS_COUNT];
+
+  sa__classify32(p, classes, masks);
+
+  return masks[0] | masks[1] | masks[2] | masks[3] | masks[4];
+}
+
+/**
+ * @brief Finds first byte that belongs to any of classes
+ * 
+ * @param p 
+ * @param pEnd nothing is read from there on
+ * @param classes SA_CHAR_* flags
+ * @return const char* found byte or pEnd
+ */
+static const char* sa__findClass(const char* p, const char* pEnd, sa_uint8_t classes) {
+#ifdef SA_SIMD_SSE2
+  // Most tokens are short, so look at few bytes one by one before paying for vector compares
+  for(const char* pProbeEnd = pEnd - p > SA_SCAN_PROBE_LENGTH ? p + SA_SCAN_PROBE_LENGTH : pEnd; p < pProbeEnd; p++) {
+    if(SA_CHAR_CLASS[(sa_uint8_t)*p] & classes)
+      return p;
+  }
+
+  while(pEnd - p >= 32) {
+    const sa_uint32_t mask = sa__classMask32(p, classes);
+
+    if(mask)
+      return p + sa__countTrailingZeros(mask);
+
+    p += 32;
+  }
+#endif
+
+  while(p < pEnd && !(SA_CHAR_CLASS[(sa_uint8_t)*p] & classes))
+    p++;
+
+  return p;
+}
+
+/**
+ * @brief Finds first byte that does not belong to any of classes
+ * 
+ * @param p 
+ * @param pEnd nothing is read from there on
+ * @param classes SA_CHAR_* flags
+ * @return const char* found byte or pEnd
+ */
+static const char* sa__skipClass(const char* p, const char* pEnd, sa_uint8_t classes) {
+#ifdef SA_SIMD_SSE2
+  // Most tokens are short, so look at few bytes one by one before paying for vector compares
+  for(const char* pProbeEnd = pEnd - p > SA_SCAN_PROBE_LENGTH ? p + SA_SCAN_PROBE_LENGTH : pEnd; p < pProbeEnd; p++) {
+    if(!(SA_CHAR_CLASS[(sa_uint8_t)*p] & classes))
+      return p;
+  }
+
+  while(pEnd - p >= 32) {
+    const sa_uint32_t mask = ~sa__classMask32(p, classes);
+
+    if(mask)
+      return p + sa__countTrailingZeros(mask);
+
+    p += 32;
+  }
+#endif
+
+  while(p < pEnd && (SA_CHAR_CLASS[(sa_uint8_t)*p] & classes))
+    p++;
+
+  return p;
+}
+
+/**
+ * @brief Counts bytes that belong to any of classes
+ * 
+ * @param p 
+ * @param pEnd nothing is read from there on
+ * @param classes SA_CHAR_* flags
+ * @return sa_uint32_t 
+ */
+static sa_uint32_t sa__countClass(const char* p, const char* pEnd, sa_uint8_t classes) {
+  sa_uint32_t count = 0;
+
+#ifdef SA_SIMD_SSE2
+  while(pEnd - p >= 32) {
+    count += sa__popCount(sa__classMask32(p, classes));
+    p += 32;
+  }
+#endif
+
+  for(; p < pEnd; p++) {
+    if(SA_CHAR_CLASS[(sa_uint8_t)*p] & classes)
+      count++;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Walks text forward one 32 byte block at a time. Block is classified once and tokens inside it are found in its bitmasks
+ */
+typedef struct sa__textScanner_s {
+  // First byte of classified block
+  const char* pBlock;
+  // Nothing is read from there on
+  const char* pEnd;
+  // Classes that are classified, only those can be found or skipped
+  sa_uint8_t classes;
+  // Bit i of masks[c] is set when pBlock[i] is of class 1 << c
+  sa_uint32_t masks[SA_CHAR_CLASS_COUNT];
+} sa__textScanner_t;
+
+static void sa__initScanner(sa__textScanner_t* pScanner, const char* pEnd, sa_uint8_t classes) {
+  sa__setMemory(pScanner, 0, sizeof(*pScanner));
+
+  pScanner->pEnd = pEnd;
+  pScanner->classes = classes;
+}
+
+static void sa__classifyScannerBlock(sa__textScanner_t* pScanner, const char* p) {
+  const char* pBlock = p;
+  char tail[32];
+
+  // Last block is copied, so nothing past end is read. Zeros belong to no class
+  if(pScanner->pEnd - p < 32) {
+    sa__setMemory(tail, 0, sizeof(tail));
+    sa__copyMemory(p, tail, (sa_uint32_t)(pScanner->pEnd - p));
+
+    pBlock = tail;
+  }
+
+  sa__classify32(pBlock, pScanner->classes, pScanner->masks);
+
+  pScanner->pBlock = p;
+}
+
+/**
+ * @brief Bitmask of classified block, bit i is set when pBlock[i] belongs to any of classes
+ * 
+ * @param pScanner 
+ * @param classes SA_CHAR_* flags
+ * @return sa_uint32_t 
+ */
+static inline sa_uint32_t sa__scannerMask(const sa__textScanner_t* pScanner, sa_uint8_t classes) {
+  return ((classes & SA_CHAR_WHITE) ? pScanner->masks[0] : 0) | ((classes & SA_CHAR_NEWLINE) ? pScanner->masks[1] : 0) |
+    ((classes & SA_CHAR_PUNCTUATOR) ? pScanner->masks[2] : 0) | ((classes & SA_CHAR_OPERATOR) ? pScanner->masks[3] : 0) |
+    ((classes & SA_CHAR_HASH) ? pScanner->masks[4] : 0);
+}
+
+/**
+ * @brief Same as sa__findClass, but uses and keeps classified block of scanner
+ * 
+ * @param pScanner 
+ * @param p 
+ * @param classes SA_CHAR_* flags, have to be classified by scanner
+ * @return const char* found byte or pScanner->pEnd
+ */
+static inline const char* sa__scanFind(sa__textScanner_t* pScanner, const char* p, sa_uint8_t classes) {
+  while(p < pScanner->pEnd) {
+    if(p < pScanner->pBlock || p - pScanner->pBlock >= 32)
+      sa__classifyScannerBlock(pScanner, p);
+
+    const sa_uint32_t mask = sa__scannerMask(pScanner, classes) >> (p - pScanner->pBlock);
+
+    if(mask)
+      return p + sa__countTrailingZeros(mask);
+
+    p = pScanner->pBlock + 32;
+  }
+
+  return pScanner->pEnd;
+}
+
+/**
+ * @brief Same as sa__skipClass, but uses and keeps classified block of scanner
+ * 
+ * @param pScanner 
+ * @param p 
+ * @param classes SA_CHAR_* flags, have to be classified by scanner
+ * @return const char* found byte or pScanner->pEnd
+ */
+static inline const char* sa__scanSkip(sa__textScanner_t* pScanner, const char* p, sa_uint8_t classes) {
+  while(p < pScanner->pEnd) {
+    if(p < pScanner->pBlock || p - pScanner->pBlock >= 32)
+      sa__classifyScannerBlock(pScanner, p);
+
+    const sa_uint32_t offset = (sa_uint32_t)(p - pScanner->pBlock);
+    // Bits shifted in from the top are past block, those are left for next block
+    const sa_uint32_t mask = (~sa__scannerMask(pScanner, classes) >> offset) & (SA_UINT32_MAX >> offset);
+
+    if(mask) {
+      // Copied last block has zeros past end, those do not belong to any class
+      const char* pFound = p + sa__countTrailingZeros(mask);
+
+      return pFound < pScanner->pEnd ? pFound : pScanner->pEnd;
+    }
+
+    p = pScanner->pBlock + 32;
+  }
+
+  return pScanner->pEnd;
+}
+
+//
+// Arena allocator
+//
+
+static sa__arenaChunk_t* sa__arenaNewChunk(sa_uint32_t capacity) {
+  sa__arenaChunk_t* pChunk = (sa__arenaChunk_t*)sa_malloc(sizeof(sa__arenaChunk_t) + capacity);
+
+  pChunk->pNext = SA_NULL;
+  pChunk->size = 0;
+  pChunk->capacity = capacity;
+
+  return pChunk;
+}
+
+/**
+ * @brief Bump allocates zeroed memory from the arena, memory lives until arena is reset or freed
+ * 
+ * @param pArena 
+ * @param size 
+ * @return void* 8 bytes aligned memory
+ */
+static void* sa__arenaAlloc(sa__arena_t* pArena, sa_uint32_t size) {
+  // Keep every allocation 8 bytes aligned
+  size = (size + 7) & ~7U;
+
+  if(!pArena->pCurrent || pArena->pCurrent->size + size > pArena->pCurrent->capacity) {
+    // Reuse chunks left after reset when they are big enough
+    if(pArena->pCurrent && pArena->pCurrent->pNext && pArena->pCurrent->pNext->capacity >= size) {
+      pArena->pCurrent = pArena->pCurrent->pNext;
+      pArena->pCurrent->size = 0;
+    }
+    else {
+      sa__arenaChunk_t* pChunk = sa__arenaNewChunk(size > SA_ARENA_CHUNK_SIZE ? size : SA_ARENA_CHUNK_SIZE);
+
+      if(pArena->pCurrent) {
+        pChunk->pNext = pArena->pCurrent->pNext;
+        pArena->pCurrent->pNext = pChunk;
+      }
+      else {
+        pChunk->pNext = pArena->pHead;
+        pArena->pHead = pChunk;
+      }
+
+      pArena->pCurrent = pChunk;
+    }
+  }
+
+  void* pMem = sa__arenaChunkData(pArena->pCurrent) + pArena->pCurrent->size;
+  pArena->pCurrent->size += size;
+
+  return sa__setMemory(pMem, 0, size);
+}
+
+/**
+ * @brief Grows allocation, in place if it is the last one in current chunk. Old memory is only reclaimed with whole arena
+ * 
+ * @param pArena 
+ * @param pMem memory from sa__arenaAlloc or SA_NULL
+ * @param oldSize 
+ * @param newSize 
+ * @return void* 
+ */
+static void* sa__arenaRealloc(sa__arena_t* pArena, void* pMem, sa_uint32_t oldSize, sa_uint32_t newSize) {
+  if(!pMem)
+    return sa__arenaAlloc(pArena, newSize);
+
+  oldSize = (oldSize + 7) & ~7U;
+  newSize = (newSize + 7) & ~7U;
+
+  if(newSize <= oldSize)
+    return pMem;
+
+  sa__arenaChunk_t* pChunk = pArena->pCurrent;
+
+  if(sa_ptr8(pMem) + oldSize == sa__arenaChunkData(pChunk) + pChunk->size && pChunk->size - oldSize + newSize <= pChunk->capacity) {
+    sa__setMemory(sa_ptr8(pMem) + oldSize, 0, newSize - oldSize);
+    pChunk->size += newSize - oldSize;
+
+    return pMem;
+  }
+
+  // Big allocations own whole chunk, such chunk can be reallocated instead of leaving old copy behind
+  if(oldSize > SA_ARENA_CHUNK_SIZE) {
+    sa__arenaChunk_t* pPrev = SA_NULL;
+
+    for(pChunk = pArena->pHead; pChunk; pPrev = pChunk, pChunk = pChunk->pNext) {
+      if(sa__arenaChunkData(pChunk) == sa_ptr8(pMem))
+        break;
+    }
+
+    if(pChunk && pChunk->size == oldSize) {
+      const sa_bool wasCurrent = pChunk == pArena->pCurrent;
+      sa__arenaChunk_t* pGrown = (sa__arenaChunk_t*)sa_realloc(pChunk, sizeof(sa__arenaChunk_t) + newSize);
+
+      sa__setMemory(sa__arenaChunkData(pGrown) + oldSize, 0, newSize - oldSize);
+      pGrown->size = newSize;
+      pGrown->capacity = newSize;
+
+      if(pPrev)
+        pPrev->pNext = pGrown;
+      else
+        pArena->pHead = pGrown;
+
+      if(wasCurrent)
+        pArena->pCurrent = pGrown;
+
+      return sa__arenaChunkData(pGrown);
+    }
+  }
+
+  return sa__copyMemory(pMem, sa__arenaAlloc(pArena, newSize), oldSize);
+}
+
+/**
+ * @brief Makes all arena memory available again without giving chunks back to the system
+ * 
+ * @param pArena 
+ */
+static void sa__arenaReset(sa__arena_t* pArena) {
+  pArena->pCurrent = pArena->pHead;
+
+  if(pArena->pCurrent)
+    pArena->pCurrent->size = 0;
+}
+
+static void sa__arenaFree(sa__arena_t* pArena) {
+  while(pArena->pHead) {
+    sa__arenaChunk_t* pNext = pArena->pHead->pNext;
+
+    sa_free(pArena->pHead);
+    pArena->pHead = pNext;
+  }
+
+  pArena->pCurrent = SA_NULL;
+}
+
+//
+// Growable arrays
+//
+
+/**
+ * @brief Makes sure array can hold needed elements, capacity grows by doubling so appending is amortized O(1)
+ * 
+ * @param pData array memory or SA_NULL
+ * @param elementSize 
+ * @param pCapacity capacity in elements, updated on growth
+ * @param needed 
+ * @param pArena arena that owns array memory or SA_NULL for heap memory
+ * @return void* array memory, may move
+ */
+static void* sa__growArray(void* pData, sa_uint32_t elementSize, sa_uint32_t* pCapacity, sa_uint32_t needed, sa__arena_t* pArena) {
+  if(needed <= *pCapacity)
+    return pData;
+
+  sa_uint32_t capacity = *pCapacity ? *pCapacity : 16;
+
+  while(capacity < needed)
+    capacity *= 2;
+
+  if(pArena)
+    pData = sa__arenaRealloc(pArena, pData, *pCapacity * elementSize, capacity * elementSize);
+  else
+    pData = sa_realloc(pData, capacity * elementSize);
+
+  *pCapacity = capacity;
+
+  return pData;
+}
+
+//
+// Error handling
+//
+
+/**
+ * @brief Forgets every diagnostic but keeps memory, limit and sink
+ * 
+ * @param pDiagnostics 
+ */
+static void sa__clearDiagnostics(sa_diagnostics_t* pDiagnostics) {
+  pDiagnostics->recordCount = 0;
+  pDiagnostics->errorCount = 0;
+  pDiagnostics->warningCount = 0;
+  pDiagnostics->stringsSize = 0;
+}
+
+static void sa__freeDiagnostics(sa_diagnostics_t* pDiagnostics) {
+  sa_free(pDiagnostics->pRecords);
+  sa_free(pDiagnostics->pStrings);
+  sa_free(pDiagnostics->pMessage);
+
+  pDiagnostics->pRecords = SA_NULL;
+  pDiagnostics->recordCount = 0;
+  pDiagnostics->recordCapacity = 0;
+  pDiagnostics->errorCount = 0;
+  pDiagnostics->warningCount = 0;
+  pDiagnostics->pStrings = SA_NULL;
+  pDiagnostics->stringsSize = 0;
+  pDiagnostics->stringsCapacity = 0;
+  pDiagnostics->pMessage = SA_NULL;
+  pDiagnostics->messageCapacity = 0;
+}
+
+/**
+ * @brief Counts diagnostic and tells if it should be recorded
+ * 
+ * @param pDiagnostics 
+ * @param severity 
+ * @return sa_bool SA_FALSE when limit of records is reached
+ */
+static sa_bool sa__countDiagnostic(sa_diagnostics_t* pDiagnostics, sa_uint8_t severity) {
+  if(severity == saSeverity_Error)
+    pDiagnostics->errorCount++;
+  else
+    pDiagnostics->warningCount++;
+
+  return pDiagnostics->limit == 0 || pDiagnostics->recordCount < pDiagnostics->limit;
+}
+
+/**
+ * @brief Records diagnostic, arguments are read as format says: %d, %c (int), %u, %x (unsigned), %f (double), %s (copied string) and %% for percent
+ * 
+ * @param pDiagnostics 
+ * @param severity 
+ * @param code 
+ * @param line 0 when diagnostic is not about text
+ * @param column 
+ * @param spanLength 
+ * @param fmt string literal, it is kept in record
+ * @param args 
+ */
+static void sa__reportV(sa_diagnostics_t* pDiagnostics, sa_uint8_t severity, sa_uint16_t code, sa_uint32_t line, sa_uint32_t column, sa_uint32_t spanLength, const char* fmt, va_list args) {
+  if(!sa__countDiagnostic(pDiagnostics, severity))
+    return;
+
+  pDiagnostics->pRecords = (sa_diagnostic_t*)sa__growArray(pDiagnostics->pRecords, sizeof(sa_diagnostic_t), &pDiagnostics->recordCapacity, pDiagnostics->recordCount + 1, SA_NULL);
+
+  sa_diagnostic_t* pRecord = &pDiagnostics->pRecords[pDiagnostics->recordCount];
+
+  pRecord->fmt = fmt;
+  pRecord->code = code;
+  pRecord->severity = severity;
+  pRecord->argCount = 0;
+  pRecord->line = line;
+  pRecord->column = column;
+  pRecord->spanLength = spanLength;
+  pRecord->strings = pDiagnostics->stringsSize;
+
+  for(const char* p = fmt; *p && pRecord->argCount < SA_DIAGNOSTIC_ARG_COUNT; p++) {
+    if(*p != '%' || !p[1])
+      continue;
+
+    sa__diagnosticArg_t* pArg = &pRecord->args[pRecord->argCount];
+
+    // Variadic arguments are promoted, char comes as int and float as double
+    switch(*++p) {
+    case 'c':
+    case 'd':
+      pArg->number = va_arg(args, sa_int32_t);
+      break;
+
+    case 'u':
+    case 'x':
+      pArg->unsignedNumber = va_arg(args, sa_uint32_t);
+      break;
+
+    case 'f':
+      pArg->real = (float)va_arg(args, double);
+      break;
+
+    case 's': {
+      const char* string = va_arg(args, const char*);
+      const sa_uint32_t length = string ? sa__lengthString(string) : 0;
+
+      pArg->stringOffset = pDiagnostics->stringsSize - pRecord->strings;
+      pDiagnostics->pStrings = (char*)sa__growArray(pDiagnostics->pStrings, sizeof(char), &pDiagnostics->stringsCapacity, pDiagnostics->stringsSize + length + 1, SA_NULL);
+      sa__copyMemory(string, &pDiagnostics->pStrings[pDiagnostics->stringsSize], length);
+      pDiagnostics->pStrings[pDiagnostics->stringsSize + length] = 0;
+      pDiagnostics->stringsSize += length + 1;
+      break;
+    }
+
+    default:
+      continue;
+    }
+
+    pRecord->argCount++;
+  }
+
+  pDiagnostics->recordCount++;
+
+  if(pDiagnostics->sink)
+    pDiagnostics->sink(pDiagnostics->pSinkUserData, pDiagnostics, pDiagnostics->recordCount - 1);
+}
+
+/**
+ * @brief Reports error that is not about any place in text
+ * 
+ * @param pCtx 
+ * @param code one of saDiagnostic_
+ * @param fmt string literal, see sa__reportV for arguments
+ * @param ... 
+ */
+static void sa__errMsg(sa_context_t* pCtx, sa_uint16_t code, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+
+  sa__reportV(&pCtx->diagnostics, saSeverity_Error, code, 0, 0, 0, fmt, args);
+
+  va_end(args);
+}
+
+/**
+ * @brief Reports error about part of text line
+ * 
+ * @param pCtx 
+ * @param code one of saDiagnostic_
+ * @param line 
+ * @param column byte column inside line, starts at 1
+ * @param spanLength length of part in bytes
+ * @param fmt string literal, see sa__reportV for arguments
+ * @param ... 
+ */
+static void sa__errAt(sa_context_t* pCtx, sa_uint16_t code, sa_uint32_t line, sa_uint32_t column, sa_uint32_t spanLength, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+
+  sa__reportV(&pCtx->diagnostics, saSeverity_Error, code, line, column, spanLength, fmt, args);
+
+  va_end(args);
+}
+
+/**
+ * @brief Moves diagnostics from one list to the end of another, limit and sink of destination apply
+ * 
+ * @param pDst 
+ * @param pSrc cleared after move
+ */
+static void sa__moveDiagnostics(sa_diagnostics_t* pDst, sa_diagnostics_t* pSrc) {
+  const sa_uint32_t stringsBase = pDst->stringsSize;
+  // Source only counted diagnostics over its limit, those are added at the end
+  sa_uint32_t errorCount = pSrc->errorCount;
+  sa_uint32_t warningCount = pSrc->warningCount;
+
+  pDst->pStrings = (char*)sa__growArray(pDst->pStrings, sizeof(char), &pDst->stringsCapacity, pDst->stringsSize + pSrc->stringsSize, SA_NULL);
+  sa__copyMemory(pSrc->pStrings, &pDst->pStrings[pDst->stringsSize], pSrc->stringsSize);
+  pDst->stringsSize += pSrc->stringsSize;
+
+  for(sa_uint32_t i = 0; i < pSrc->recordCount; i++) {
+    if(pSrc->pRecords[i].severity == saSeverity_Error)
+      errorCount--;
+    else
+      warningCount--;
+
+    if(!sa__countDiagnostic(pDst, pSrc->pRecords[i].severity))
+      continue;
+
+    pDst->pRecords = (sa_diagnostic_t*)sa__growArray(pDst->pRecords, sizeof(sa_diagnostic_t), &pDst->recordCapacity, pDst->recordCount + 1, SA_NULL);
+    pDst->pRecords[pDst->recordCount] = pSrc->pRecords[i];
+    pDst->pRecords[pDst->recordCount].strings += stringsBase;
+    pDst->recordCount++;
+
+    if(pDst->sink)
+      pDst->sink(pDst->pSinkUserData, pDst, pDst->recordCount - 1);
+  }
+
+  pDst->errorCount += errorCount;
+  pDst->warningCount += warningCount;
+
+  sa__clearDiagnostics(pSrc);
+}
+
+typedef struct sa__textWriter_s {
+  char* pBuffer;
+  sa_uint32_t capacity;
+  // Length of whole text, also the part that did not fit
+  sa_uint32_t length;
+} sa__textWriter_t;
+
+static void sa__writeText(sa__textWriter_t* pWriter, const char* text, sa_uint32_t length) {
+  for(sa_uint32_t i = 0; i < length; i++, pWriter->length++) {
+    // Last character of buffer is kept for null
+    if(pWriter->length + 1 < pWriter->capacity)
+      pWriter->pBuffer[pWriter->length] = text[i];
+  }
+}
+
+/**
+ * @brief Makes text of diagnostic, same as snprintf it is cut to fit the buffer
+ * 
+ * @param pDiagnostics 
+ * @param index index of record
+ * @param pBuffer can be SA_NULL when bufferSize is 0
+ * @param bufferSize 
+ * @return sa_uint32_t length of whole text without null, buffer was too small when it is not less than bufferSize
+ */
+static sa_uint32_t sa_formatDiagnostic(const sa_diagnostics_t* pDiagnostics, sa_uint32_t index, char* pBuffer, sa_uint32_t bufferSize) {
+  sa__textWriter_t writer = { pBuffer, bufferSize, 0 };
+  char number[32];
+
+  if(index < pDiagnostics->recordCount) {
+    const sa_diagnostic_t* pRecord = &pDiagnostics->pRecords[index];
+    const sa__diagnosticArg_t* pArg = pRecord->args;
+
+    for(const char* p = pRecord->fmt; *p; p++) {
+      if(*p != '%' || !p[1]) {
+        sa__writeText(&writer, p, 1);
+
+        continue;
+      }
+
+      // Record holds only as many arguments as there are slots
+      const sa_bool hasArg = pArg < pRecord->args + pRecord->argCount;
+
+      switch(*++p) {
+      case 'c':
+        number[0] = hasArg ? (char)pArg->number : '?';
+        sa__writeText(&writer, number, 1);
+        break;
+
+      case 'd':
+        sa__writeText(&writer, number, hasArg ? sa__intToString(pArg->number, number) : 0);
+        break;
+
+      case 'u':
+        sa__writeText(&writer, number, hasArg ? sa__uintToString(pArg->unsignedNumber, number) : 0);
+        break;
+
+      case 'x':
+        sa__writeText(&writer, number, hasArg ? sa__hexToString(pArg->unsignedNumber, number) : 0);
+        break;
+
+      case 'f':
+        sa__writeText(&writer, number, hasArg ? sa__floatToString(pArg->real, 6, number) : 0);
+        break;
+
+      case 's': {
+        const char* string = hasArg ? &pDiagnostics->pStrings[pRecord->strings + pArg->stringOffset] : "";
+
+        sa__writeText(&writer, string, sa__lengthString(string));
+        break;
+      }
+
+      case '%':
+        sa__writeText(&writer, "%", 1);
+        continue;
+
+      default:
+        sa__writeText(&writer, p - 1, 2);
+        continue;
+      }
+
+      pArg += hasArg;
+    }
+
+    // Place in text goes at the end, same way for every message
+    if(pRecord->line) {
+      sa__writeText(&writer, " @ line ", 8);
+      sa__writeText(&writer, number, sa__intToString((sa_int32_t)pRecord->line, number));
+    }
+  }
+
+  if(bufferSize)
+    pBuffer[writer.length < bufferSize ? writer.length : bufferSize - 1] = 0;
+
+  return writer.length;
+}
+
+/**
+ * @brief Makes text of diagnostic in buffer owned by diagnostics
+ * 
+ * @param pDiagnostics 
+ * @param index index of record
+ * @return const char* valid until next call with the same diagnostics, empty for wrong index
+ */
+static const char* sa_diagnosticMessage(sa_diagnostics_t* pDiagnostics, sa_uint32_t index) {
+  const sa_uint32_t length = sa_formatDiagnostic(pDiagnostics, index, pDiagnostics->pMessage, pDiagnostics->messageCapacity);
+
+  if(length >= pDiagnostics->messageCapacity) {
+    pDiagnostics->pMessage = (char*)sa__growArray(pDiagnostics->pMessage, sizeof(char), &pDiagnostics->messageCapacity, length + 1, SA_NULL);
+    sa_formatDiagnostic(pDiagnostics, index, pDiagnostics->pMessage, pDiagnostics->messageCapacity);
+  }
+
+  return pDiagnostics->pMessage;
+}
+
+/**
+ * @brief Prepares context, every thread assembling at the same time needs its own
+ * 
+ * @param pCtx 
+ */
+static void sa_initContext(sa_context_t* pCtx) {
+  sa__setMemory(pCtx, 0, sizeof(*pCtx));
+  pCtx->idGeneratorHoldValue = 1;
+}
+
+/**
+ * @brief Frees diagnostics held by context
+ * 
+ * @param pCtx 
+ */
+static void sa_freeContext(sa_context_t* pCtx) {
+  sa__freeDiagnostics(&pCtx->diagnostics);
+}
+
+/**
+ * @brief Context used by entry points when SA_NULL is passed, shared by whole process
+ * 
+ * @return sa_context_t* 
+ */
+static sa_context_t* sa_defaultContext() {
+  return &__gDefaultContext;
+}
+
+static sa_context_t* sa__resolveContext(sa_context_t* pCtx) {
+  return pCtx ? pCtx : &__gDefaultContext;
+}
+
+//
+// String interning pool
+//
+
+/**
+ * @brief FNV-1a hash of a string slice
+ * 
+ * @param str 
+ * @param length 
+ * @return sa_uint32_t 
+ */
+static sa_uint32_t sa__hashString(const char* str, sa_uint32_t length) {
+  sa_uint32_t hash = 2166136261U;
+
+  for(sa_uint32_t i = 0; i < length; i++) {
+    hash ^= (sa_uint8_t)str[i];
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Gets pooled string, pointer is valid until next string is interned
+ * 
+ * @param pPool 
+ * @param handle 
+ * @return const char* null terminated string
+ */
+static const char* sa__poolString(const sa__stringPool_t* pPool, sa_uint32_t handle) {
+  return &pPool->pData[handle];
+}
+
+/**
+ * @brief Finds already interned string
+ * 
+ * @param pPool 
+ * @param str doesn't need to be null terminated
+ * @param length 
+ * @return sa_uint32_t handle or SA_UINT32_MAX if string was never interned
+ */
+static sa_uint32_t sa__findString(const sa__stringPool_t* pPool, const char* str, sa_uint32_t length) {
+  if(pPool->slotCount == 0)
+    return SA_UINT32_MAX;
+
+  const sa_uint32_t mask = pPool->slotCount - 1;
+  sa_uint32_t slot = sa__hashString(str, length) & mask;
+
+  while(pPool->pSlots[slot] != 0) {
+    const sa_uint32_t handle = pPool->pSlots[slot] - 1;
+    const char* pooled = &pPool->pData[handle];
+    sa_uint32_t i = 0;
+
+    // Pooled string ends with \0, so shorter pooled string stops the loop by itself
+    while(i < length && pooled[i] == str[i])
+      i++;
+
+    if(i == length && pooled[length] == 0)
+      return handle;
+
+    slot = (slot + 1) & mask;
+  }
+
+  return SA_UINT32_MAX;
+}
+
+static void sa__insertStringSlot(sa__stringPool_t* pPool, sa_uint32_t handle, sa_uint32_t length) {
+  const sa_uint32_t mask = pPool->slotCount - 1;
+  sa_uint32_t slot = sa__hashString(&pPool->pData[handle], length) & mask;
+
+  while(pPool->pSlots[slot] != 0)
+    slot = (slot + 1) & mask;
+
+  pPool->pSlots[slot] = handle + 1;
+}
+
+/**
+ * @brief Interns string, same strings always get same handle
+ * 
+ * @param pPool 
+ * @param str doesn't need to be null terminated
+ * @param length 
+ * @return sa_uint32_t handle to the string, use sa__poolString to read it
+ */
+static sa_uint32_t sa__internString(sa__stringPool_t* pPool, const char* str, sa_uint32_t length) {
+  sa_uint32_t handle = sa__findString(pPool, str, length);
+
+  if(handle != SA_UINT32_MAX)
+    return handle;
+
+  pPool->pData = (char*)sa__growArray(pPool->pData, sizeof(char), &pPool->capacity, pPool->size + length + 1, SA_NULL);
+
+  handle = pPool->size;
+  sa__copyMemory(str, &pPool->pData[handle], length);
+  pPool->pData[handle + length] = 0;
+  pPool->size += length + 1;
+  pPool->stringCount++;
+
+  // Grow at 50% load and reinsert every string, strings are stored one after another
+  if(pPool->stringCount * 2 > pPool->slotCount) {
+    sa_free(pPool->pSlots);
+
+    pPool->slotCount = pPool->slotCount ? pPool->slotCount * 2 : 64;
+    pPool->pSlots = (sa_uint32_t*)sa_calloc(pPool->slotCount, sizeof(sa_uint32_t));
+
+    sa_uint32_t offset = 0;
+
+    while(offset < pPool->size) {
+      const sa_uint32_t stringLength = sa__lengthString(&pPool->pData[offset]);
+
+      sa__insertStringSlot(pPool, offset, stringLength);
+      offset += stringLength + 1;
+    }
+  }
+  else {
+    sa__insertStringSlot(pPool, handle, length);
+  }
+
+  return handle;
+}
+
+/**
+ * @brief Empties pool but keeps its memory for next strings
+ * 
+ * @param pPool 
+ */
+static void sa__resetStringPool(sa__stringPool_t* pPool) {
+  pPool->size = 0;
+  pPool->stringCount = 0;
+
+  if(pPool->pSlots)
+    sa__setMemory(pPool->pSlots, 0, pPool->slotCount * sizeof(sa_uint32_t));
+}
+
+static void sa__freeStringPool(sa__stringPool_t* pPool) {
+  sa_free(pPool->pData);
+  pPool->pData = SA_NULL;
+  pPool->size = 0;
+  pPool->capacity = 0;
+
+  sa_free(pPool->pSlots);
+  pPool->pSlots = SA_NULL;
+  pPool->slotCount = 0;
+  pPool->stringCount = 0;
+}
+
+//
+// SPIR-V ID gen
+//
+
+static sa_uint32_t sa__genId(sa_context_t* pCtx) {
+  return pCtx->idGeneratorHoldValue++;
+}
+
+static void sa__resetId(sa_context_t* pCtx) {
+  pCtx->idGeneratorHoldValue = 1;
+}
+
+static sa_uint32_t sa__getOperandSectionType(sa_uint16_t op) {
+  // Unknown opcodes are treated as function body
+  if(op >= SA_OPCODE_COUNT || !SA_ASSEMBLER_OPCODE_INFO[op].mnemonic)
+    return saSectionType_Functions;
+
+  return SA_ASSEMBLER_OPCODE_INFO[op].section;
+}
+
+/**
+ * @brief Finds index of the first id with that name
+ * 
+ * @param pIds 
+ * @param name 
+ * @return sa_uint32_t index to pIds->pIds or SA_UINT32_MAX if there is no such name
+ */
+static sa_uint32_t sa__findSpirvIdIndex(const sa__spirvIdTable_t* pIds, const char* name, sa_uint32_t length) {
+  if(pIds->nameSlotCount == 0)
+    return SA_UINT32_MAX;
+
+  // Name that was never interned cannot belong to any id
+  const sa_uint32_t handle = sa__findString(&pIds->names, name, length);
+
+  if(handle == SA_UINT32_MAX)
+    return SA_UINT32_MAX;
+
+  // Slot count is always power of 2, so mask works as modulo
+  const sa_uint32_t mask = pIds->nameSlotCount - 1;
+  sa_uint32_t slot = (handle * 2654435761U) & mask;
+
+  // Load factor is kept under 50%, there is always empty slot to stop on
+  while(pIds->pNameSlots[slot] != 0) {
+    const sa_uint32_t index = pIds->pNameSlots[slot] - 1;
+
+    if(pIds->pIds[index].textId == handle)
+      return index;
+
+    slot = (slot + 1) & mask;
+  }
+
+  return SA_UINT32_MAX;
+}
+
+static void sa__insertSpirvIdSlot(sa__spirvIdTable_t* pIds, sa_uint32_t index) {
+  const sa_uint32_t mask = pIds->nameSlotCount - 1;
+  sa_uint32_t slot = (pIds->pIds[index].textId * 2654435761U) & mask;
+
+  while(pIds->pNameSlots[slot] != 0)
+    slot = (slot + 1) & mask;
+
+  // Store index + 1 as 0 is reserved for empty slot
+  pIds->pNameSlots[slot] = index + 1;
+}
+
+static void sa__rehashSpirvIdTable(sa__spirvIdTable_t* pIds, sa_uint32_t slotCount) {
+  sa_free(pIds->pNameSlots);
+
+  pIds->nameSlotCount = slotCount;
+  pIds->pNameSlots = (sa_uint32_t*)sa_calloc(slotCount, sizeof(sa_uint32_t));
+
+  for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
+    // Only first id with given name is reachable by name, same as linear search was
+    const char* name = sa__poolString(&pIds->names, pIds->pIds[i].textId);
+
+    if(sa__findSpirvIdIndex(pIds, name, sa__lengthString(name)) == SA_UINT32_MAX)
+      sa__insertSpirvIdSlot(pIds, i);
+  }
+}
+
+/**
+ * @brief Makes sure flat reverse index can hold ids up to (excluding) bounds
+ * 
+ * @param pIds 
+ * @param bounds highest id + 1, like header.bounds
+ * @return sa_bool SA_FALSE if bounds exceed SA_MAX_DENSE_SPIRV_ID
+ */
+static sa_bool sa__reserveSpirvIdBounds(sa__spirvIdTable_t* pIds, sa_uint32_t bounds) {
+  if(bounds <= pIds->idSlotCount)
+    return SA_TRUE;
+
+  if(bounds > SA_MAX_DENSE_SPIRV_ID)
+    return SA_FALSE;
+
+  const sa_uint32_t oldSlotCount = pIds->idSlotCount;
+
+  pIds->pIdSlots = (sa_uint32_t*)sa__growArray(pIds->pIdSlots, sizeof(sa_uint32_t), &pIds->idSlotCount, bounds, SA_NULL);
+  sa__setMemory(&pIds->pIdSlots[oldSlotCount], 0, (pIds->idSlotCount - oldSlotCount) * sizeof(sa_uint32_t));
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Finds index of the first entry with that binary id
+ * 
+ * @param pIds 
+ * @param id 
+ * @return sa_uint32_t index to pIds->pIds or SA_UINT32_MAX if there is no such id
+ */
+static sa_uint32_t sa__findSpirvIdIndexById(const sa__spirvIdTable_t* pIds, sa_uint32_t id) {
+  // Only ids that do not fit in the flat index need a scan
+  if(id >= SA_MAX_DENSE_SPIRV_ID) {
+    for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
+      if(pIds->pIds[i].binaryId == id)
+        return i;
+    }
+
+    return SA_UINT32_MAX;
+  }
+
+  if(id < pIds->idSlotCount)
+    return pIds->pIdSlots[id] - 1;
+
+  return SA_UINT32_MAX;
+}
+
+/**
+ * @brief Pre-sizes id table for expected amount of ids, so adding them does not reallocate
+ * 
+ * @param pIds 
+ * @param count 
+ */
+static void sa__reserveSpirvIds(sa__spirvIdTable_t* pIds, sa_uint32_t count) {
+  pIds->pIds = (sa__spirvId_t*)sa__growArray(pIds->pIds, sizeof(sa__spirvId_t), &pIds->idCapacity, count, SA_NULL);
+
+  sa_uint32_t slotCount = pIds->nameSlotCount ? pIds->nameSlotCount : 64;
+
+  while(slotCount < count * 2)
+    slotCount *= 2;
+
+  if(slotCount > pIds->nameSlotCount)
+    sa__rehashSpirvIdTable(pIds, slotCount);
+
+  sa__reserveSpirvIdBounds(pIds, count + 1);
+}
+
+/**
+ * @brief Appends new id entry and makes it reachable by name (if that name is not taken yet)
+ * 
+ * @param pIds 
+ * @param name 
+ * @param id 
+ * @return sa_uint32_t index of new entry
+ */
+static sa_uint32_t sa__pushSpirvId(sa__spirvIdTable_t* pIds, const char* name, sa_uint32_t length, sa_uint32_t id) {
+  pIds->idCount++;
+  pIds->pIds = (sa__spirvId_t*)sa__growArray(pIds->pIds, sizeof(sa__spirvId_t), &pIds->idCapacity, pIds->idCount, SA_NULL);
+  sa__setMemory(&pIds->pIds[pIds->idCount - 1], 0, sizeof(pIds->pIds[pIds->idCount - 1]));
+  pIds->pIds[pIds->idCount - 1].binaryId = id;
+  pIds->pIds[pIds->idCount - 1].textId = sa__internString(&pIds->names, name, length);
+
+  // Grow at 50% load, rehash also inserts the new entry
+  if(pIds->idCount * 2 > pIds->nameSlotCount) {
+    sa__rehashSpirvIdTable(pIds, pIds->nameSlotCount ? pIds->nameSlotCount * 2 : 64);
+  }
+  else if(sa__findSpirvIdIndex(pIds, name, length) == SA_UINT32_MAX) {
+    sa__insertSpirvIdSlot(pIds, pIds->idCount - 1);
+  }
+
+  // Same as with names, only first entry with given id is reachable
+  if(id < SA_MAX_DENSE_SPIRV_ID && sa__reserveSpirvIdBounds(pIds, id + 1) && pIds->pIdSlots[id] == 0)
+    pIds->pIdSlots[id] = pIds->idCount;
+
+  return pIds->idCount - 1;
+}
+
+/**
+ * @brief Notes use of id, ids used first have to come in order of their numbers
+ * 
+ * @param pUseOrder 
+ * @param id 
+ */
+static void sa__useSpirvId(sa__idUseOrder_t* pUseOrder, sa_uint32_t id) {
+  if(id == pUseOrder->next)
+    pUseOrder->next++;
+  else if(id > pUseOrder->next)
+    pUseOrder->broken = SA_TRUE;
+}
+
+/**
+ * @brief Gets id for name, new one is generated when name was not seen yet
+ * 
+ * @param pCtx 
+ * @param pIds 
+ * @param name does not need to be null terminated
+ * @param length length of name
+ * @return sa_uint32_t 
+ */
+static sa_uint32_t sa__getOrCreateSpirvIdLength(sa_context_t* pCtx, sa__spirvIdTable_t* pIds, const char* name, sa_uint32_t length) {
+  sa_uint32_t index = sa__findSpirvIdIndex(pIds, name, length);
+
+  if(index == SA_UINT32_MAX)
+    index = sa__pushSpirvId(pIds, name, length, sa__genId(pCtx));
+
+  if(pIds->pUseOrder)
+    sa__useSpirvId(pIds->pUseOrder, pIds->pIds[index].binaryId);
+
+  return pIds->pIds[index].binaryId;
+}
+
+static sa_uint32_t sa__getOrCreateSpirvId(sa_context_t* pCtx, sa__spirvIdTable_t* pIds, const char* name) {
+  return sa__getOrCreateSpirvIdLength(pCtx, pIds, name, sa__lengthString(name));
+}
+
+static void sa__createSpirvNameId(sa__spirvIdTable_t* pIds, const char* name, sa_uint32_t id) {
+  sa__pushSpirvId(pIds, name, sa__lengthString(name), id);
+}
+
+static sa_bool sa__spirvIdExist(sa__spirvIdTable_t* pIds, sa_uint32_t id) {
+  return sa__findSpirvIdIndexById(pIds, id) != SA_UINT32_MAX;
+}
+
+static sa_bool sa__spirvIdNameExist(sa__spirvIdTable_t* pIds, const char* name) {
+  return sa__findSpirvIdIndex(pIds, name, sa__lengthString(name)) != SA_UINT32_MAX;
+}
+
+static void sa__createJustId(sa_context_t* pCtx, sa__spirvIdTable_t* pIds, sa_uint32_t id) {
+  if(sa__spirvIdExist(pIds, id))
+    return;
+
+  sa__pushSpirvId(pIds, "", 0, sa__genId(pCtx));
+}
+
+static const char* sa__getSpirvName(sa__spirvIdTable_t* pIds, sa_uint32_t id) {
+  sa_uint32_t index = sa__findSpirvIdIndexById(pIds, id);
+
+  if(index == SA_UINT32_MAX)
+    return SA_NULL;
+
+  return sa__poolString(&pIds->names, pIds->pIds[index].textId);
+}
+
+static sa_uint32_t sa__getSpirvId(sa__spirvIdTable_t* pIds, const char* name) {
+  sa_uint32_t index = sa__findSpirvIdIndex(pIds, name, sa__lengthString(name));
+
+  if(index == SA_UINT32_MAX)
+    return SA_UINT32_MAX;
+
+  return pIds->pIds[index].binaryId;
+}
+
+/**
+ * @brief Empties id table but keeps its memory, for assembling many files one after another
+ * 
+ * @param pIds 
+ */
+static void sa__resetSpirvIdTable(sa__spirvIdTable_t* pIds) {
+  pIds->idCount = 0;
+
+  sa__resetStringPool(&pIds->names);
+
+  if(pIds->pNameSlots)
+    sa__setMemory(pIds->pNameSlots, 0, pIds->nameSlotCount * sizeof(sa_uint32_t));
+
+  if(pIds->pIdSlots)
+    sa__setMemory(pIds->pIdSlots, 0, pIds->idSlotCount * sizeof(sa_uint32_t));
+}
+
+static void sa__freeSpirvIdTable(sa__spirvIdTable_t* pIds) {
+  sa_free(pIds->pIds);
+  pIds->pIds = SA_NULL;
+  pIds->idCount = 0;
+  pIds->idCapacity = 0;
+
+  sa__freeStringPool(&pIds->names);
+
+  sa_free(pIds->pNameSlots);
+  pIds->pNameSlots = SA_NULL;
+  pIds->nameSlotCount = 0;
+
+  sa_free(pIds->pIdSlots);
+  pIds->pIdSlots = SA_NULL;
+  pIds->idSlotCount = 0;
+}
+
+/**
+ * @brief Checks if such a mnemonic is valid SPIRV operand, binary search over SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED
+ * 
+ * @param mnemonic does not need to be null terminated
+ * @param length length of mnemonic
+ * @return sa_uint32_t index to that operand table or UINT32_MAX if non existant
+ */
+static sa_uint32_t sa__findLowLevelMnemonic(const char* mnemonic, sa_uint32_t length) {
+  sa_uint32_t low = 0;
+  sa_uint32_t high = sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED) / sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[0]);
+
+  while(low < high) {
+    const sa_uint32_t middle = low + (high - low) / 2;
+    const sa_uint32_t index = SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[middle];
+    const int cmp = sa__compareStringLength(SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcodeMnemonic, mnemonic, length);
+
+    if(cmp == 0)
+      return index;
+
+    if(cmp < 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  return SA_UINT32_MAX;
+}
+
+/**
+ * @brief Finds enumerant value by mnemonic, binary search over SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_NAME
+ * 
+ * @param kind saAsmEnum_*
+ * @param name does not need to be null terminated
+ * @param length length of name
+ * @return sa_uint32_t enumerant value or SA_UINT32_MAX if kind has no such mnemonic
+ */
+static sa_uint32_t sa__findEnumerant(sa_uint32_t kind, const char* name, sa_uint32_t length) {
+  if(kind >= saAsmEnum_COUNT)
+    return SA_UINT32_MAX;
+
+  sa_uint32_t low = 0;
+  sa_uint32_t high = SA_ASSEMBLER_LOW_LEVEL_ENUMS_COUNT[kind];
+
+  while(low < high) {
+    const sa_uint32_t middle = low + (high - low) / 2;
+    const sa_uint32_t index = SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_NAME[kind][middle];
+    const int cmp = sa__compareStringLength(SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][index].enumerantMnemonic, name, length);
+
+    if(cmp == 0)
+      return SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][index].enumerant;
+
+    if(cmp < 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  return SA_UINT32_MAX;
+}
+
+/**
+ * @brief Reverse of sa__findEnumerant, for turning binary back into text
+ * 
+ * @param kind saAsmEnum_*
+ * @param value enumerant value
+ * @return const char* mnemonic (first one when there are aliases) or SA_NULL
+ */
+static const char* sa__enumerantToString(sa_uint32_t kind, sa_uint32_t value) {
+  if(kind >= saAsmEnum_COUNT)
+    return SA_NULL;
+
+  sa_uint32_t low = 0;
+  sa_uint32_t high = SA_ASSEMBLER_LOW_LEVEL_ENUMS_COUNT[kind];
+
+  // Lower bound, so with aliases first entry from table is found
+  while(low < high) {
+    const sa_uint32_t middle = low + (high - low) / 2;
+
+    if(SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_VALUE[kind][middle]].enumerant < value)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  if(low < SA_ASSEMBLER_LOW_LEVEL_ENUMS_COUNT[kind] && SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_VALUE[kind][low]].enumerant == value)
+    return SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_VALUE[kind][low]].enumerantMnemonic;
+
+  return SA_NULL;
+}
+
+/**
+ * @brief Checks that lookup tables agree with each other, worth calling once in debug builds or after editing tables
+ * 
+ * @param pCtx context receiving error for every broken entry, can be SA_NULL
+ * @return sa_bool SA_TRUE when tables are in sync
+ */
+static sa_bool sa_checkTables(sa_context_t* pCtx) {
+  pCtx = sa__resolveContext(pCtx);
+
+  sa_bool valid = SA_TRUE;
+  const sa_uint32_t count = sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED) / sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[0]);
+
+  for(sa_uint32_t i = 0; i < count; i++) {
+    const sa_uint32_t index = SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[i];
+
+    if(index >= count) {
+      sa__errMsg(pCtx, saDiagnostic_Internal, "Sorted opcode index %d is out of range", i);
+      valid = SA_FALSE;
+
+      continue;
+    }
+
+    // Strict order also means every mnemonic is there only once
+    if(i > 0 && SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[i - 1] < count) {
+      const char* prev = SA_ASSEMBLER_LOW_LEVEL_OPCODES[SA_ASSEMBLER_LOW_LEVEL_OPCODES_SORTED[i - 1]].opcodeMnemonic;
+      const char* curr = SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcodeMnemonic;
+
+      if(sa__compareStringLength(prev, curr, sa__lengthString(curr)) >= 0) {
+        sa__errMsg(pCtx, saDiagnostic_Internal, "Opcode %s is not sorted after %s", curr, prev);
+        valid = SA_FALSE;
+      }
+    }
+
+    if(sa__findLowLevelMnemonic(SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcodeMnemonic, sa__lengthString(SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcodeMnemonic)) != index) {
+      sa__errMsg(pCtx, saDiagnostic_Internal, "Opcode %s cannot be found", SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcodeMnemonic);
+      valid = SA_FALSE;
+    }
+
+    const sa_uint32_t opcode = SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcode;
+
+    if(opcode >= SA_OPCODE_COUNT || SA_ASSEMBLER_OPCODE_INFO[opcode].tableIndex != index || !SA_ASSEMBLER_OPCODE_INFO[opcode].mnemonic ||
+      sa__compareString(SA_ASSEMBLER_OPCODE_INFO[opcode].mnemonic, SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcodeMnemonic) != 0 ||
+      SA_ASSEMBLER_OPCODE_INFO[opcode].minWordCount != SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].wordCount ||
+      SA_ASSEMBLER_OPCODE_INFO[opcode].variadic != SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].plusVariable) {
+      sa__errMsg(pCtx, saDiagnostic_Internal, "Opcode info of %s does not match opcode table", SA_ASSEMBLER_LOW_LEVEL_OPCODES[index].opcodeMnemonic);
+      valid = SA_FALSE;
+    }
+  }
+
+  for(sa_uint32_t kind = 0; kind < saAsmEnum_COUNT; kind++) {
+    const sa_uint32_t enumCount = SA_ASSEMBLER_LOW_LEVEL_ENUMS_COUNT[kind];
+
+    // Table ends with SA_NULL mnemonic right after the last entry
+    if(enumCount >= SA_MAX_ENUMERANT_ENTRIES || SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][enumCount].enumerantMnemonic || (enumCount > 0 && !SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][enumCount - 1].enumerantMnemonic)) {
+      sa__errMsg(pCtx, saDiagnostic_Internal, "Enumerant count of kind %d does not match its table", kind);
+      valid = SA_FALSE;
+
+      continue;
+    }
+
+    for(sa_uint32_t i = 0; i < enumCount; i++) {
+      const sa_uint32_t byName = SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_NAME[kind][i];
+      const sa_uint32_t byValue = SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_VALUE[kind][i];
+
+      if(byName >= enumCount || byValue >= enumCount) {
+        sa__errMsg(pCtx, saDiagnostic_Internal, "Sorted enumerant index %d of kind %d is out of range", i, kind);
+        valid = SA_FALSE;
+
+        continue;
+      }
+
+      if(i == 0)
+        continue;
+
+      const sa_uint32_t prevByName = SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_NAME[kind][i - 1];
+      const sa_uint32_t prevByValue = SA_ASSEMBLER_LOW_LEVEL_ENUMS_BY_VALUE[kind][i - 1];
+
+      if(prevByName < enumCount && sa__compareStringLength(SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][prevByName].enumerantMnemonic, SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][byName].enumerantMnemonic, sa__lengthString(SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][byName].enumerantMnemonic)) >= 0) {
+        sa__errMsg(pCtx, saDiagnostic_Internal, "Enumerant %s is not sorted after %s", SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][byName].enumerantMnemonic, SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][prevByName].enumerantMnemonic);
+        valid = SA_FALSE;
+      }
+
+      if(prevByValue < enumCount && SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][prevByValue].enumerant > SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][byValue].enumerant) {
+        sa__errMsg(pCtx, saDiagnostic_Internal, "Enumerant %s is not sorted by value", SA_ASSEMBLER_LOW_LEVEL_ENUMS[kind][byValue].enumerantMnemonic);
+        valid = SA_FALSE;
+      }
+    }
+  }
+
+  // Class table is written out by hand, every byte has to match the character lists
+  for(sa_uint32_t c = 0; c < 256; c++) {
+    sa_uint8_t expected = 0;
+
+    for(const char* p = SA_WHITE_CHARS; *p; p++)
+      if((sa_uint8_t)*p == c) expected |= SA_CHAR_WHITE;
+    for(const char* p = SA_PUNCTUATOR_CHARS; *p; p++)
+      if((sa_uint8_t)*p == c) expected |= SA_CHAR_PUNCTUATOR;
+    for(const char* p = SA_OPERATOR_CHARS; *p; p++)
+      if((sa_uint8_t)*p == c) expected |= SA_CHAR_OPERATOR;
+    if(c == '\n') expected |= SA_CHAR_NEWLINE;
+    if(c == '#') expected |= SA_CHAR_HASH;
+
+    if(SA_CHAR_CLASS[c] != expected) {
+      sa__errMsg(pCtx, saDiagnostic_Internal, "Character class of byte %d does not match character lists", c);
+      valid = SA_FALSE;
+    }
+  }
+
+  return valid;
+}
+
+/**
+ * @brief Allocator of section words, arena unless assembly is only baked
+ * 
+ * @param pAssembly 
+ * @return sa__arena_t* SA_NULL for heap
+ */
+static sa__arena_t* sa__wordArena(sa_assembly_t* pAssembly) {
+  return pAssembly->bakeOnly ? SA_NULL : &pAssembly->arena;
+}
+
+/**
+ * @brief Remembers where instruction starts, nothing is kept for assemblies that are only baked
+ * 
+ * @param pAssembly 
+ * @param section 
+ * @param start word offset of instruction
+ */
+static void sa__pushInstructionOffset(sa_assembly_t* pAssembly, sa_uint32_t section, sa_uint32_t start) {
+  sa__assemblySection_t* pSection = &pAssembly->section[section];
+
+  pSection->instCount++;
+
+  if(pAssembly->bakeOnly)
+    return;
+
+  pSection->pInstOffsets = (sa_uint32_t*)sa__growArray(pSection->pInstOffsets, sizeof(sa_uint32_t), &pSection->instCapacity, pSection->instCount, &pAssembly->arena);
+  pSection->pInstOffsets[pSection->instCount - 1] = start;
+}
+
+/**
+ * @brief 
+ * 
+ * @param pAssembly 
+ * @param section section type the instruction goes to
+ * @param wordSize Includes opcode 
+ * @param op opcode
+ * @param words all the parameters
+ */
+static void sa__addInstruction(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa_uint32_t section, sa_uint16_t wordSize, sa_uint16_t op, sa_uint32_t* words) {
+  if(!pAssembly || section >= saSectionType_COUNT) {
+    sa__errMsg(pCtx, saDiagnostic_Internal, "Cannot find section");
+    
+    return;
+  }
+
+  sa__assemblySection_t* pSection = &pAssembly->section[section];
+
+  sa__pushInstructionOffset(pAssembly, section, pSection->wordCount);
+
+  pSection->pWords = (sa_uint32_t*)sa__growArray(pSection->pWords, sizeof(sa_uint32_t), &pSection->wordCapacity, pSection->wordCount + wordSize, sa__wordArena(pAssembly));
+  pSection->pWords[pSection->wordCount] = SA_CONVERT((((sa_uint32_t)wordSize) << 16) | op);
+
+  sa__copyWords(words, &pSection->pWords[pSection->wordCount + 1], wordSize - 1);
+
+  pSection->wordCount += wordSize;
+}
+
+/**
+ * @brief Appends single word to section, used between sa__beginInstruction and sa__endInstruction
+ * 
+ * @param pAssembly 
+ * @param section 
+ * @param word already encoded word
+ */
+static void sa__pushInstructionWord(sa_assembly_t* pAssembly, sa_uint32_t section, sa_uint32_t word) {
+  sa__assemblySection_t* pSection = &pAssembly->section[section];
+
+  pSection->pWords = (sa_uint32_t*)sa__growArray(pSection->pWords, sizeof(sa_uint32_t), &pSection->wordCapacity, pSection->wordCount + 1, sa__wordArena(pAssembly));
+  pSection->pWords[pSection->wordCount] = word;
+  pSection->wordCount++;
+}
+
+/**
+ * @brief Starts instruction that is written word by word straight into section
+ * 
+ * @param pAssembly 
+ * @param section section type the instruction goes to
+ * @return sa_uint32_t word offset of instruction, needed by sa__endInstruction and sa__abortInstruction
+ */
+static sa_uint32_t sa__beginInstruction(sa_assembly_t* pAssembly, sa_uint32_t section) {
+  const sa_uint32_t start = pAssembly->section[section].wordCount;
+
+  // Placeholder for (wordSize << 16) | opcode, filled when instruction ends
+  sa__pushInstructionWord(pAssembly, section, 0);
+
+  return start;
+}
+
+/**
+ * @brief Drops everything written since sa__beginInstruction
+ * 
+ * @param pAssembly 
+ * @param section 
+ * @param start value returned by sa__beginInstruction
+ */
+static void sa__abortInstruction(sa_assembly_t* pAssembly, sa_uint32_t section, sa_uint32_t start) {
+  pAssembly->section[section].wordCount = start;
+}
+
+/**
+ * @brief Finishes instruction started with sa__beginInstruction
+ * 
+ * @param pCtx 
+ * @param pAssembly 
+ * @param section 
+ * @param start value returned by sa__beginInstruction
+ * @param op opcode
+ * @return sa_bool SA_FALSE if instruction does not fit 16 bit word count, it is dropped then
+ */
+static sa_bool sa__endInstruction(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa_uint32_t section, sa_uint32_t start, sa_uint16_t op) {
+  sa__assemblySection_t* pSection = &pAssembly->section[section];
+  const sa_uint32_t wordSize = pSection->wordCount - start;
+
+  if(wordSize > SA_UINT16_MAX) {
+    sa__errMsg(pCtx, saDiagnostic_TooManyWords, "Instruction %s has too many words (%d)", sa__opcodeToString(op), wordSize);
+    sa__abortInstruction(pAssembly, section, start);
+
+    return SA_FALSE;
+  }
+
+  pSection->pWords[start] = SA_CONVERT((wordSize << 16) | op);
+
+  sa__pushInstructionOffset(pAssembly, section, start);
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Gets view of instruction inside a section
+ * 
+ * @param pSection 
+ * @param index instruction index, must be lower than instCount
+ * @return sa__assemblyInstruction_t view valid until section grows
+ */
+static sa__assemblyInstruction_t sa__getInstruction(const sa__assemblySection_t* pSection, sa_uint32_t index) {
+  sa__assemblyInstruction_t inst;
+  sa_uint32_t* pFirst = &pSection->pWords[pSection->pInstOffsets[index]];
+
+  inst.opCode = SA_CONVERT(*pFirst) & 0x0000FFFF;
+  inst.wordSize = (SA_CONVERT(*pFirst) >> 16) & 0x0000FFFF;
+  inst.words = pFirst + 1;
+
+  return inst;
+}
+
+/**
+ * @brief Pre-sizes section for expected amount of instructions and words
+ * 
+ * @param pAssembly 
+ * @param section section type
+ * @param instCount 
+ * @param wordCount words of all the instructions together (opcode words included)
+ */
+static void sa_reserveSection(sa_assembly_t* pAssembly, sa_uint32_t section, sa_uint32_t instCount, sa_uint32_t wordCount) {
+  sa__assemblySection_t* pSection = &pAssembly->section[section];
+
+  if(!pAssembly->bakeOnly)
+    pSection->pInstOffsets = (sa_uint32_t*)sa__growArray(pSection->pInstOffsets, sizeof(sa_uint32_t), &pSection->instCapacity, instCount, &pAssembly->arena);
+
+  pSection->pWords = (sa_uint32_t*)sa__growArray(pSection->pWords, sizeof(sa_uint32_t), &pSection->wordCapacity, wordCount, sa__wordArena(pAssembly));
+}
+
+static void sa_freeAssembly(sa_assembly_t* pAsm) {
+  // Every section lives in the arena, so there is nothing to free one by one
+  sa__arenaFree(&pAsm->arena);
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    // Words of assembly that is only baked are on heap
+    if(pAsm->bakeOnly)
+      sa_free(pAsm->section[sect].pWords);
+
+    sa__setMemory(&pAsm->section[sect], 0, sizeof(pAsm->section[sect]));
+  }
+
+  pAsm->bakeOnly = SA_FALSE;
+
+  pAsm->header.bounds = 0;
+  pAsm->header.generator = 0;
+  pAsm->header.magic = 0;
+  pAsm->header.schema = 0;
+  pAsm->header.version = 0;
+}
+
+static void sa_freeSPIRV(sa_uint8_t* spirvBin) {
+  sa_free(spirvBin);
+}
+
+/**
+ * @brief Gets enum for instruction. Instruction must support that enum
+ * 
+ * @param instructionIndex index to the instruction/opcode table
+ * @param enumName enum mnemonic, does not need to be null terminated
+ * @param enumNameLength length of enumName
+ * @return sa_uint32_t enum or SA_UINT32_t on error
+ */
+static sa_uint32_t sa__getLowLevelInstructionEnum(sa_uint32_t instructionIndex, const char* enumName, sa_uint32_t enumNameLength) {
+  for(sa_uint32_t eId = 0; eId < saAsmEnum_COUNT; eId++) {
+    sa_uint32_t tableId = SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].possibleEnumerant[eId];
+
+    if(tableId == SA_UINT32_MAX)
+      break;
+
+    sa_uint32_t enumerant = sa__findEnumerant(tableId, enumName, enumNameLength);
+
+    if(enumerant != SA_UINT32_MAX)
+      return enumerant;
+  }
+
+  return SA_UINT32_MAX;
+}
+
+static sa_uint32_t sa__parserLowLevelSkipComment(sa__textScanner_t* pScanner, const char * const spirvAssemblyStrStart, const char * const spirvAssemblyStrEnd) {
+  const char* p = spirvAssemblyStrStart;
+
+  if(p >= spirvAssemblyStrEnd)
+    return 0;
+
+  // If after skipping all the white spaces p == NL, return it as a just an empty line
+  if(*p == '\n') {
+    p++;
+
+    return p - spirvAssemblyStrStart; 
+  }
+
+  if(*p == ';') {
+    // Skip comment (full line)
+    p = sa__scanFind(pScanner, p, SA_CHAR_NEWLINE);
+
+    if(p == spirvAssemblyStrEnd)
+      return p - spirvAssemblyStrStart;
+
+    // Skip NL char
+    p++;
+
+    // return pointer to the next line
+    return p - spirvAssemblyStrStart;
+  }
+
+  return SA_UINT32_MAX;
+}
+
+/**
+ * @brief White characters inside of a line, \r is there so CRLF input needs no preprocessing
+ * 
+ * @param c 
+ * @return sa_bool 
+ */
+static sa_bool sa__isParserWhite(sa_uint8_t c) {
+  return (SA_CHAR_CLASS[c] & SA_CHAR_WHITE) != 0;
+}
+
+/**
+ * @brief Copies token into null terminated buffer for messages, clamped to buffer size
+ * 
+ * @param pToken 
+ * @param length length of token
+ * @param pBuffer 
+ * @param bufferSize 
+ * @return char* pBuffer
+ */
+static char* sa__copyTokenForMessage(const char* pToken, sa_uint32_t length, char* pBuffer, sa_uint32_t bufferSize) {
+  if(length > bufferSize - 1)
+    length = bufferSize - 1;
+
+  sa__copyMemory(pToken, pBuffer, length);
+  pBuffer[length] = 0;
+
+  return pBuffer;
+}
+
+static void sa__pushIdWordRef(sa__parallelIds_t* pParallel, sa_uint32_t section, sa_uint32_t offset) {
+  pParallel->idWordCount++;
+  pParallel->pIdWords = (sa__idWordRef_t*)sa__growArray(pParallel->pIdWords, sizeof(sa__idWordRef_t), &pParallel->idWordCapacity, pParallel->idWordCount, SA_NULL);
+  pParallel->pIdWords[pParallel->idWordCount - 1].section = section;
+  pParallel->pIdWords[pParallel->idWordCount - 1].offset = offset;
+}
+
+/**
+ * @brief Finds last numeric type declared before literal in whole text, for chunks of parallel assembly
+ * 
+ * @param pIds chunk id table
+ * @param pType chunk local entry of type id
+ * @param pLiteral literal inside whole text
+ * @return const sa__spirvId_t* declaration or pType when there is none before literal
+ */
+static const sa__spirvId_t* sa__findParallelType(const sa__spirvIdTable_t* pIds, const sa__spirvId_t* pType, const char* pLiteral) {
+  const sa__parallelIds_t* pParallel = pIds->pParallel;
+  const char* name = sa__poolString(&pIds->names, pType->textId);
+  const sa_uint32_t offset = pLiteral - pParallel->pText;
+  sa_uint32_t index = sa__findSpirvIdIndex(pParallel->pTypes, name, sa__lengthString(name));
+
+  if(index == SA_UINT32_MAX || pParallel->pTypes->pIds[index].binaryId >= offset)
+    return pType;
+
+  // Type can be declared again later, last declaration before literal is the one that counts
+  while(pParallel->pNextTypes[index] != SA_UINT32_MAX && pParallel->pTypes->pIds[pParallel->pNextTypes[index]].binaryId < offset)
+    index = pParallel->pNextTypes[index];
+
+  return &pParallel->pTypes->pIds[index];
+}
+
+/**
+ * @brief Writes numeric literal operand. Literal is encoded by its type when known, 64-bit types take two words with low-order word first
+ * 
+ * @param pAssembly 
+ * @param section section of instruction
+ * @param str text of the literal
+ * @param length 
+ * @param pNumber parsed literal
+ * @param pType id of TypeInt / TypeFloat the literal belongs to or SA_NULL when there is no such
+ * @return sa_bool SA_FALSE if literal cannot be represented by its type
+ */
+static sa_bool sa__pushNumberLiteral(sa_assembly_t* pAssembly, sa_uint32_t section, const char* str, sa_uint32_t length, const sa__number_t* pNumber, const sa__spirvId_t* pType) {
+  sa_uint64_t bits = 0;
+  sa_uint32_t wordCount = 1;
+
+  if(pType && pType->numericKind == saNumberKind_Float) {
+    if(pType->numericWidth == 32) {
+      float value = sa__numberToFloat(str, length, pNumber);
+      sa_uint32_t floatBits;
+      sa__copyMemory(&value, &floatBits, sizeof(floatBits));
+      bits = floatBits;
+    }
+    else if(pType->numericWidth == 64) {
+      double value = sa__numberToDouble(str, length, pNumber);
+      sa__copyMemory(&value, &bits, sizeof(bits));
+      wordCount = 2;
+    }
+    else {
+      return SA_FALSE;
+    }
+  }
+  else if(pType && pType->numericKind == saNumberKind_Integer) {
+    const sa_uint32_t width = pType->numericWidth;
+
+    if(pNumber->kind != saNumberKind_Integer || pNumber->overflow || width == 0 || width > 64)
+      return SA_FALSE;
+
+    // Any bit pattern that fits is accepted, negative values only for signed types
+    if(pNumber->negative) {
+      if(!pType->numericSigned || pNumber->integer > (1ULL << (width - 1)))
+        return SA_FALSE;
+
+      bits = 0 - pNumber->integer;
+    }
+    else {
+      if(width < 64 && (pNumber->integer >> width))
+        return SA_FALSE;
+
+      bits = pNumber->integer;
+    }
+
+    // Types narrower than word are sign extended when signed and zero extended otherwise
+    if(width < 64) {
+      if(pType->numericSigned && ((bits >> (width - 1)) & 1))
+        bits |= SA_UINT64_MAX << width;
+      else
+        bits &= (1ULL << width) - 1;
+    }
+
+    wordCount = width > 32 ? 2 : 1;
+  }
+  else if(pNumber->kind == saNumberKind_Float) {
+    float value = sa__numberToFloat(str, length, pNumber);
+    sa_uint32_t floatBits;
+    sa__copyMemory(&value, &floatBits, sizeof(floatBits));
+    bits = floatBits;
+  }
+  else {
+    if(pNumber->overflow || (pNumber->negative && pNumber->integer > (1ULL << 63)))
+      return SA_FALSE;
+
+    if(pNumber->negative) {
+      bits = 0 - pNumber->integer;
+      wordCount = pNumber->integer > (1ULL << 31) ? 2 : 1;
+    }
+    else {
+      bits = pNumber->integer;
+      wordCount = (bits >> 32) ? 2 : 1;
+    }
+  }
+
+  sa__pushInstructionWord(pAssembly, section, SA_CONVERT((sa_uint32_t)bits));
+
+  if(wordCount == 2)
+    sa__pushInstructionWord(pAssembly, section, SA_CONVERT((sa_uint32_t)(bits >> 32)));
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Parses instruction to the spirv assembly struct. Text is tokenized in place and operands are written straight into destination section
+ * 
+ * @param spirvAssemblyStrStart string of a spirv assembly where spirvAssemblyStrStart[0] == first letter of a operand mnemonic
+ * @param spirvAssemblyStrEnd end of whole text, nothing is read from there on
+ * @param pScanner scanner over the same text that ends at spirvAssemblyStrEnd, classifies white and new line characters
+ * @param pAssembly pointer to the assemblt
+ * @param pInsideFn set to true if operand is inside function, this is required to skip most of opcodes that would be created in wrong section, like variables 
+ * @return sa_uint32_t index to the next operand or SA_UINT32_MAX on error
+ */
+static sa_uint32_t sa__parseLowLevelInstruction(sa_context_t* pCtx, const char * const spirvAssemblyStrStart, const char * const spirvAssemblyStrEnd, sa__textScanner_t* pScanner, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa_bool* pInsideFn, sa_uint32_t line) {
+  if(!spirvAssemblyStrStart) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "Cannot find start point for assembly plain");
+
+    return SA_UINT32_MAX;
+  }
+
+  if(!pAssembly) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "Cannot find assembly struct");
+
+    return SA_UINT32_MAX;
+  }
+
+  if(!pIds) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "Cannot find spirv IDs table");
+
+    return SA_UINT32_MAX;
+  }
+
+  const char* p = spirvAssemblyStrStart;
+  const char* const pEnd = spirvAssemblyStrEnd;
+
+  // Skip all white chars at the beginning as they are valid 
+  p = sa__scanSkip(pScanner, p, SA_CHAR_WHITE);
+
+  sa_uint32_t skipCommentSize = sa__parserLowLevelSkipComment(pScanner, p, pEnd);
+
+  if(skipCommentSize != SA_UINT32_MAX)
+    return (p - spirvAssemblyStrStart) + skipCommentSize;
+
+  // That should be mnemonic start
+  const char* mnemonicStart = p;
+
+  // Everything in lowest level assembly is divided by spaces, 1 instruction per line
+  p = sa__scanFind(pScanner, p, SA_CHAR_WHITE | SA_CHAR_NEWLINE);
+
+  const sa_uint32_t mnemonicLength = p - mnemonicStart;
+
+  // Check if mnemonic actually exist
+  sa_uint32_t instructionIndex = sa__findLowLevelMnemonic(mnemonicStart, mnemonicLength);
+
+  if(instructionIndex == SA_UINT32_MAX) {
+    char mnemonic[256];
+
+    sa__errAt(pCtx, saDiagnostic_UnknownMnemonic, line, mnemonicStart - spirvAssemblyStrStart + 1, mnemonicLength, "Mnemonic \"%s\" does not exist", sa__copyTokenForMessage(mnemonicStart, mnemonicLength, mnemonic, sizeof(mnemonic)));
+
+    return SA_UINT32_MAX;
+  }
+
+  sa_uint16_t operand = SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].opcode;
+  sa_uint16_t minimalWordCount = SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].wordCount;
+
+  if(operand == saOp_Function)
+    *pInsideFn = SA_TRUE;
+
+  if(operand == saOp_FunctionEnd)
+    *pInsideFn = SA_FALSE;
+
+  // Section is known up front, so operands can go straight there
+  sa_uint32_t operandSection = sa__getOperandSectionType(operand);
+  sa_bool canBeInsideFunction = SA_TRUE;
+
+  if(operandSection == saSectionType_Types && operand != saOp_Variable && operand != saOp_Line && operand != saOp_Undef) {
+    canBeInsideFunction = SA_FALSE;
+  }
+
+  if(canBeInsideFunction && *pInsideFn)
+    operandSection = saSectionType_Functions;
+
+  const sa_uint32_t start = sa__beginInstruction(pAssembly, operandSection);
+
+  // Numeric types and constants need to know which id they describe, that is always the first one
+  const sa_bool tracksNumericType = operand == saOp_TypeInt || operand == saOp_TypeFloat || operand == saOp_Constant || operand == saOp_SpecConstant;
+  sa_uint32_t firstIdIndex = SA_UINT32_MAX;
+  // Capability needed by execution model of EntryPoint, added only when EntryPoint itself is
+  sa_uint32_t capability = 0;
+  
+  while(p < pEnd && *p != '\n') {
+    p = sa__scanSkip(pScanner, p, SA_CHAR_WHITE);
+
+    const char* arg = p;
+
+    p = sa__scanFind(pScanner, p, SA_CHAR_WHITE | SA_CHAR_NEWLINE);
+
+    const sa_uint32_t argLength = p - arg;
+
+    // Trailing white characters are not an argument
+    if(argLength == 0)
+      continue;
+
+    // Words written so far, without opcode word
+    const sa_uint32_t wordsSize = pAssembly->section[operandSection].wordCount - start - 1;
+
+    // Check if function is not extendable yet exceeds word count
+    if(!SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].plusVariable && wordsSize > (sa_uint32_t)(minimalWordCount - 1)) {
+      sa__errAt(pCtx, saDiagnostic_TooManyOperands, line, arg - spirvAssemblyStrStart + 1, argLength, "%s is not extendable type, yet assembler found more than %d arguments", SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].opcodeMnemonic, minimalWordCount);
+      sa__abortInstruction(pAssembly, operandSection, start);
+
+      return SA_UINT32_MAX;
+    }
+
+    sa__number_t number;
+
+    if(arg[0] == '%') {
+      sa_uint32_t id = sa__getOrCreateSpirvIdLength(pCtx, pIds, arg + 1, argLength - 1);
+      sa__pushInstructionWord(pAssembly, operandSection, SA_CONVERT(id));
+
+      if(pIds->pParallel)
+        sa__pushIdWordRef(pIds->pParallel, operandSection, pAssembly->section[operandSection].wordCount - 1);
+
+      if(tracksNumericType && firstIdIndex == SA_UINT32_MAX)
+        firstIdIndex = sa__findSpirvIdIndex(pIds, arg + 1, argLength - 1);
+    }
+    else if(sa__parseNumber(arg, argLength, &number)) {
+      // Only constants take type from their first id, type declarations get plain literals
+      const sa_bool isConstant = operand == saOp_Constant || operand == saOp_SpecConstant;
+      const sa__spirvId_t* pType = (isConstant && firstIdIndex != SA_UINT32_MAX) ? &pIds->pIds[firstIdIndex] : SA_NULL;
+
+      // Type may be declared by earlier chunk of parallel assembly
+      if(pType && pType->numericKind == saNumberKind_None && pIds->pParallel)
+        pType = sa__findParallelType(pIds, pType, arg);
+
+      if(!sa__pushNumberLiteral(pAssembly, operandSection, arg, argLength, &number, pType)) {
+        char literal[256];
+
+        sa__errAt(pCtx, saDiagnostic_LiteralOutOfRange, line, arg - spirvAssemblyStrStart + 1, argLength, "Literal %s cannot be represented by its type", sa__copyTokenForMessage(arg, argLength, literal, sizeof(literal)));
+        sa__abortInstruction(pAssembly, operandSection, start);
+
+        return SA_UINT32_MAX;
+      }
+    }
+    else if(arg[0] == '\"' && arg[argLength - 1] == '\"') {
+      const char* string = &arg[1];
+      const sa_uint32_t stringLength = argLength >= 2 ? argLength - 2 : 0;
+
+      // Literal string is null terminated and padded with zeros to full word
+      for(sa_uint32_t j = 0; j < ((stringLength + 1) + 3) / sizeof(sa_uint32_t); j++) {
+        sa_uint32_t tmpWord = 0;
+
+        for(sa_uint32_t k = 0; k < 4 && (j * 4 + k) < stringLength; k++)
+          tmpWord |= ((sa_uint32_t)(sa_uint8_t)string[j * 4 + k]) << (8 * k);
+
+        sa__pushInstructionWord(pAssembly, operandSection, SA_CONVERT(tmpWord));
+      }
+    }
+    else {
+      sa_uint32_t enumerant = sa__getLowLevelInstructionEnum(instructionIndex, arg, argLength);
+
+      sa__pushInstructionWord(pAssembly, operandSection, SA_CONVERT(enumerant));
+
+      if(operand == saOp_EntryPoint) {
+        switch (enumerant) {
+        case saEntryPoint_Vertex:
+        case saEntryPoint_Fragment:
+        case saEntryPoint_GLCompute:
+          capability = saCapability_Shader;
+
+          break;
+
+        case saEntryPoint_TessellationControl:
+        case saEntryPoint_TessellationEvaluation:
+          capability = saCapability_Tesselation;
+
+          break;
+
+        case saEntryPoint_Geometry:
+          capability = saCapability_Geometry;
+          
+          break;
+        }
+      }
+
+      if(enumerant == SA_UINT32_MAX) {
+        char enumName[256];
+
+        sa__errAt(pCtx, saDiagnostic_WrongEnumerant, line, arg - spirvAssemblyStrStart + 1, argLength, "Wrong enumerant for %s: %s", sa__opcodeToString(operand), sa__copyTokenForMessage(arg, argLength, enumName, sizeof(enumName)));
+        sa__abortInstruction(pAssembly, operandSection, start);
+
+        return SA_UINT32_MAX;
+      }
+    }
+  }
+
+  // Remember what numeric type declares, words are result id, width and signedness
+  if((operand == saOp_TypeInt || operand == saOp_TypeFloat) && firstIdIndex != SA_UINT32_MAX && pAssembly->section[operandSection].wordCount - start >= 3) {
+    const sa_uint32_t* pWords = &pAssembly->section[operandSection].pWords[start];
+    sa__spirvId_t* pType = &pIds->pIds[firstIdIndex];
+
+    pType->numericKind = operand == saOp_TypeInt ? saNumberKind_Integer : saNumberKind_Float;
+    pType->numericWidth = (sa_uint8_t)SA_CONVERT(pWords[2]);
+    pType->numericSigned = operand == saOp_TypeFloat || (pAssembly->section[operandSection].wordCount - start >= 4 && SA_CONVERT(pWords[3]) != 0);
+  }
+
+  // Add instruction
+  if(!sa__endInstruction(pCtx, pAssembly, operandSection, start, operand))
+    return SA_UINT32_MAX;
+
+  if(capability)
+    sa__addInstruction(pCtx, pAssembly, saSectionType_Capability, 2, saOp_Capability, &capability);
+
+  return p - spirvAssemblyStrStart;
+}
+
+/**
+ * @brief Starts incremental assembly, text is then passed with sa_assembleFeed and finished with sa_assembleEnd
+ * 
+ * @param pCtx context, SA_NULL for default one
+ * @param pAssembler state to initialize
+ * @param pAssembly assembly to fill, has to stay valid until sa_assembleEnd
+ */
+static void sa_assembleBegin(sa_context_t* pCtx, sa_assembler_t* pAssembler, sa_assembly_t* pAssembly) {
+  sa__setMemory(pAssembler, 0, sizeof(*pAssembler));
+
+  pAssembler->pCtx = sa__resolveContext(pCtx);
+  pAssembler->pAssembly = pAssembly;
+  pAssembler->line = 1;
+
+  sa__resetId(pAssembler->pCtx);
+  sa__clearDiagnostics(&pAssembler->pCtx->diagnostics);
+
+  sa_uint32_t memoryModelWords[2] = {saAddresingModel_Logical, saMemoryModel_Vulkan};
+  sa__addInstruction(pAssembler->pCtx, pAssembly, saSectionType_MemoryModel, 3, saOp_MemoryModel, memoryModelWords);
+}
+
+/**
+ * @brief Parses whole lines of text, last line may only be unfinished when there is no more text to come
+ * 
+ * @param pAssembler 
+ * @param spirvBasicAssembly text starting at line start
+ * @param length 
+ */
+static void sa__assembleLines(sa_assembler_t* pAssembler, const char* spirvBasicAssembly, sa_uint32_t length) {
+  sa_uint32_t index = 0;
+  // Lines are read front to back, so every block of text is classified once for all tokens in it
+  sa__textScanner_t scanner;
+
+  sa__initScanner(&scanner, &spirvBasicAssembly[length], SA_CHAR_WHITE | SA_CHAR_NEWLINE);
+
+  while(index < length) {
+    const sa_uint32_t previous = index;
+    const sa_uint32_t idWordCount = pAssembler->ids.pParallel ? pAssembler->ids.pParallel->idWordCount : 0;
+    sa_uint32_t next = sa__parseLowLevelInstruction(pAssembler->pCtx, &spirvBasicAssembly[index], &spirvBasicAssembly[length], &scanner, pAssembler->pAssembly, &pAssembler->ids, &pAssembler->insideFn, pAssembler->line);
+
+    if(next == SA_UINT32_MAX) {
+      // Failed instruction was dropped, so are its id words
+      if(pAssembler->ids.pParallel)
+        pAssembler->ids.pParallel->idWordCount = idWordCount;
+
+      index = sa__scanFind(&scanner, &spirvBasicAssembly[index], SA_CHAR_NEWLINE) - spirvBasicAssembly;
+      
+      if(index < length)
+        index++;
+
+      //sa__errMsg(pCtx, "Something went wrong @ line %d", line);
+
+      //return;
+    }
+
+    if(next != SA_UINT32_MAX) {
+      index += next;
+    }
+
+    // Instructions stop before new line and empty lines, comments and failed lines consume only theirs, so line ends when last passed byte is new line
+    if(index > previous && spirvBasicAssembly[index - 1] == '\n')
+      pAssembler->line++;
+  }
+}
+
+static void sa__appendPending(sa_assembler_t* pAssembler, const char* text, sa_uint32_t length) {
+  pAssembler->pPending = (char*)sa__growArray(pAssembler->pPending, sizeof(char), &pAssembler->pendingCapacity, pAssembler->pendingSize + length, SA_NULL);
+  sa__copyMemory(text, &pAssembler->pPending[pAssembler->pendingSize], length);
+  pAssembler->pendingSize += length;
+}
+
+/**
+ * @brief Assembles next chunk of text. Chunk can end anywhere, also in the middle of line, and is not used after the call
+ * 
+ * @param pAssembler state started with sa_assembleBegin
+ * @param chunk text, does not need to be null terminated
+ * @param length length of chunk in bytes
+ */
+static void sa_assembleFeed(sa_assembler_t* pAssembler, const char* chunk, sa_uint32_t length) {
+  // Everything after last new line waits for the rest of its line
+  sa_uint32_t completeLength = length;
+
+  while(completeLength > 0 && chunk[completeLength - 1] != '\n')
+    completeLength--;
+
+  if(completeLength == 0) {
+    sa__appendPending(pAssembler, chunk, length);
+
+    return;
+  }
+
+  sa_uint32_t index = 0;
+
+  // Line that started in previous chunk is finished by the start of this one
+  if(pAssembler->pendingSize > 0) {
+    index = sa__findClass(chunk, chunk + completeLength, SA_CHAR_NEWLINE) - chunk + 1;
+
+    sa__appendPending(pAssembler, chunk, index);
+    sa__assembleLines(pAssembler, pAssembler->pPending, pAssembler->pendingSize);
+    pAssembler->pendingSize = 0;
+  }
+
+  // Whole lines are parsed in place
+  sa__assembleLines(pAssembler, &chunk[index], completeLength - index);
+  sa__appendPending(pAssembler, &chunk[completeLength], length - completeLength);
+}
+
+/**
+ * @brief Adds Name for every id starting at given one, except ids written as %%number
+ * 
+ * @param pAssembler 
+ * @param firstIndex index of first id in id table
+ */
+static void sa__addIdNames(sa_assembler_t* pAssembler, sa_uint32_t firstIndex) {
+  sa_assembly_t* pAssembly = pAssembler->pAssembly;
+  sa__spirvIdTable_t* pIds = &pAssembler->ids;
+
+  const sa_uint32_t nameSection = sa__getOperandSectionType(saOp_Name);
+
+  for(sa_uint32_t i = firstIndex; i < pIds->idCount; i++) {
+    const char* name = sa__poolString(&pIds->names, pIds->pIds[i].textId);
+
+    if(name[0] != '%') {
+      const sa_uint32_t nameLength = sa__lengthString(name);
+      // +3 to add 1 more uint if there is not equal amount of bytes
+      const sa_uint32_t nameWords = ((nameLength + 1) + 3) / sizeof(sa_uint32_t);
+      const sa_uint32_t start = sa__beginInstruction(pAssembly, nameSection);
+
+      sa__pushInstructionWord(pAssembly, nameSection, SA_CONVERT(pIds->pIds[i].binaryId));
+
+      // Bytes past the name are padding zeros
+      for(sa_uint32_t j = 0; j < nameWords; j++) {
+        sa_uint32_t word = 0;
+
+        for(sa_uint32_t k = 0; k < 4 && j * 4 + k < nameLength; k++)
+          word |= (((sa_uint32_t)(sa_uint8_t)name[j * 4 + k]) << (8 * k));
+
+        sa__pushInstructionWord(pAssembly, nameSection, SA_CONVERT(word));
+      }
+
+      sa__endInstruction(pAssembler->pCtx, pAssembly, nameSection, start, saOp_Name);
+    }
+  }
+}
+
+/**
+ * @brief Parses what is left of the text and adds names, id table is kept so it can be reused
+ * 
+ * @param pAssembler state started with sa_assembleBegin
+ */
+static void sa__finishAssembly(sa_assembler_t* pAssembler) {
+  // Last line does not need new line
+  if(pAssembler->pendingSize > 0)
+    sa__assembleLines(pAssembler, pAssembler->pPending, pAssembler->pendingSize);
+
+  pAssembler->pAssembly->header.bounds = pAssembler->ids.idCount + 1;
+
+  sa__addIdNames(pAssembler, 0);
+}
+
+/**
+ * @brief Parses what is left of the text, adds names and frees assembler state. Assembly is complete after that
+ * 
+ * @param pAssembler state started with sa_assembleBegin
+ */
+static void sa_assembleEnd(sa_assembler_t* pAssembler) {
+  sa__finishAssembly(pAssembler);
+  sa__freeSpirvIdTable(&pAssembler->ids);
+
+  if(pAssembler->pPending)
+    sa_free(pAssembler->pPending);
+
+  pAssembler->pPending = SA_NULL;
+  pAssembler->pendingSize = 0;
+  pAssembler->pendingCapacity = 0;
+}
+
+/**
+ * @brief Assembles text slice, it does not need to be null terminated (mapped files, part of bigger buffer)
+ * 
+ * @param pCtx context, SA_NULL for default one
+ * @param spirvBasicAssembly text to process
+ * @param length length of text in bytes
+ * @param pAssembly assembly to fill
+ */
+static void sa_assembleSPIRVN(sa_context_t* pCtx, const char* spirvBasicAssembly, sa_uint32_t length, sa_assembly_t* pAssembly) {
+  sa_assembler_t assembler;
+
+  sa_assembleBegin(pCtx, &assembler, pAssembly);
+
+  // Only counted to size tables up front, text itself is parsed in place
+  const sa_uint32_t lineCount = 1 + sa__countClass(spirvBasicAssembly, spirvBasicAssembly + length, SA_CHAR_NEWLINE);
+
+  // Most lines declare one id and most of them are function bodies
+  sa__reserveSpirvIds(&assembler.ids, lineCount);
+  sa_reserveSection(pAssembly, saSectionType_Functions, lineCount, lineCount * 4);
+
+  // Whole text is one chunk, so nothing is carried and nothing is copied
+  sa__assembleLines(&assembler, spirvBasicAssembly, length);
+  sa_assembleEnd(&assembler);
+}
+
+/**
+ * @brief Assembles null terminated text
+ * 
+ * @param pCtx context, SA_NULL for default one
+ * @param spirvBasicAssembly text to process
+ * @param pAssembly assembly to fill
+ */
+static void sa_assembleSPIRV(sa_context_t* pCtx, const char* spirvBasicAssembly, sa_assembly_t* pAssembly) {
+  sa_assembleSPIRVN(pCtx, spirvBasicAssembly, sa__lengthString(spirvBasicAssembly), pAssembly);
+}
+
+//
+// Threads
+//
+
+// Work run by sa__runOnThreads, item is one element of the array passed there
+typedef void (*sa__threadWork_t)(void* pItem);
+
+typedef struct sa__threadTask_s {
+  sa__threadWork_t pfnWork;
+  void* pItem;
+} sa__threadTask_t;
+
+#ifdef SA_ENABLE_THREADS
+#if defined(_WIN32)
+static DWORD WINAPI sa__threadEntry(LPVOID pUserData) {
+  sa__threadTask_t* pTask = (sa__threadTask_t*)pUserData;
+
+  pTask->pfnWork(pTask->pItem);
+
+  return 0;
+}
+#else
+static void* sa__threadEntry(void* pUserData) {
+  sa__threadTask_t* pTask = (sa__threadTask_t*)pUserData;
+
+  pTask->pfnWork(pTask->pItem);
+
+  return SA_NULL;
+}
+#endif
+#endif
+
+/**
+ * @brief Runs work for every item, on own thread each when SA_ENABLE_THREADS is defined. First item always runs on calling thread, so does every item that did not get a thread
+ * 
+ * @param pfnWork 
+ * @param pItems array of items
+ * @param itemSize size of one item in bytes
+ * @param itemCount 
+ */
+static void sa__runOnThreads(sa__threadWork_t pfnWork, void* pItems, sa_uint32_t itemSize, sa_uint32_t itemCount) {
+#ifdef SA_ENABLE_THREADS
+  sa__threadTask_t* pTasks = (sa__threadTask_t*)sa_calloc(itemCount, sizeof(sa__threadTask_t));
+
+  for(sa_uint32_t i = 0; i < itemCount; i++) {
+    pTasks[i].pfnWork = pfnWork;
+    pTasks[i].pItem = sa_ptr8(pItems) + (sa_uint64_t)i * itemSize;
+  }
+
+#if defined(_WIN32)
+  HANDLE* pThreads = (HANDLE*)sa_calloc(itemCount, sizeof(HANDLE));
+
+  for(sa_uint32_t i = 1; i < itemCount; i++)
+    pThreads[i] = CreateThread(SA_NULL, 0, sa__threadEntry, &pTasks[i], 0, SA_NULL);
+
+  pfnWork(pTasks[0].pItem);
+
+  for(sa_uint32_t i = 1; i < itemCount; i++) {
+    if(!pThreads[i]) {
+      pfnWork(pTasks[i].pItem);
+
+      continue;
+    }
+
+    WaitForSingleObject(pThreads[i], INFINITE);
+    CloseHandle(pThreads[i]);
+  }
+#else
+  pthread_t* pThreads = (pthread_t*)sa_calloc(itemCount, sizeof(pthread_t));
+  sa_bool* pStarted = (sa_bool*)sa_calloc(itemCount, sizeof(sa_bool));
+
+  for(sa_uint32_t i = 1; i < itemCount; i++)
+    pStarted[i] = pthread_create(&pThreads[i], SA_NULL, sa__threadEntry, &pTasks[i]) == 0;
+
+  pfnWork(pTasks[0].pItem);
+
+  for(sa_uint32_t i = 1; i < itemCount; i++) {
+    if(!pStarted[i]) {
+      pfnWork(pTasks[i].pItem);
+
+      continue;
+    }
+
+    pthread_join(pThreads[i], SA_NULL);
+  }
+
+  sa_free(pStarted);
+#endif
+
+  sa_free(pThreads);
+  sa_free(pTasks);
+#else
+  for(sa_uint32_t i = 0; i < itemCount; i++)
+    pfnWork(sa_ptr8(pItems) + (sa_uint64_t)i * itemSize);
+#endif
+}
+
+//
+// Parallel assembly
+//
+
+// One range of text that is assembled on its own, ranges start at Function lines
+typedef struct sa__parallelChunk_s {
+  const char* pText;
+  sa_uint32_t length;
+  // Line number of first line of the chunk
+  sa_uint32_t line;
+  // Amount of line breaks inside the chunk
+  sa_uint32_t lineBreaks;
+  // Stage that sa__runParallelChunks runs for the chunk
+  void (*pfnStage)(struct sa__parallelChunk_s* pChunk);
+  // TypeInt / TypeFloat declared inside the chunk, binaryId holds text offset of the declaration
+  sa__spirvIdTable_t types;
+  sa_context_t ctx;
+  sa_assembly_t assembly;
+  sa__parallelIds_t parallel;
+  sa_assembler_t assembler;
+  // Filled by merge, global id of every chunk id and where chunk instructions go in pTarget
+  sa_assembly_t* pTarget;
+  sa_uint32_t* pIdMap;
+  sa_uint32_t instBase[saSectionType_COUNT];
+  sa_uint32_t wordBase[saSectionType_COUNT];
+} sa__parallelChunk_t;
+
+/**
+ * @brief Compares token with null terminated keyword
+ * 
+ * @param token 
+ * @param length length of token
+ * @param keyword 
+ * @return sa_bool 
+ */
+static sa_bool sa__tokenEquals(const char* token, sa_uint32_t length, const char* keyword) {
+  return sa__compareStringLength(keyword, token, length) == 0;
+}
+
+/**
+ * @brief Reads next white separated token of line
+ * 
+ * @param ppText current position, moved past the token
+ * @param pEnd 
+ * @param pLength length of the token
+ * @return const char* token start, empty token at line end
+ */
+static const char* sa__nextLineToken(const char** ppText, const char* pEnd, sa_uint32_t* pLength) {
+  const char* token = sa__skipClass(*ppText, pEnd, SA_CHAR_WHITE);
+
+  *ppText = sa__findClass(token, pEnd, SA_CHAR_WHITE | SA_CHAR_NEWLINE);
+  *pLength = *ppText - token;
+
+  return token;
+}
+
+/**
+ * @brief Moves past line break that ends current line
+ * 
+ * @param p 
+ * @param pEnd 
+ * @return const char* start of next line or pEnd
+ */
+static const char* sa__nextLine(const char* p, const char* pEnd) {
+  p = sa__findClass(p, pEnd, SA_CHAR_NEWLINE);
+
+  return p < pEnd ? p + 1 : pEnd;
+}
+
+/**
+ * @brief Splits text into up to chunkCount ranges of similar size. Function always opens a function, so assembler state after Function line does not depend on what was before and every Function line can start a chunk
+ * 
+ * @param text 
+ * @param length 
+ * @param pChunks array of chunkCount chunks, only text and length are filled
+ * @param chunkCount 
+ * @return sa_uint32_t amount of chunks actually used
+ */
+static sa_uint32_t sa__splitParallelChunks(const char* text, sa_uint32_t length, sa__parallelChunk_t* pChunks, sa_uint32_t chunkCount) {
+  const char* const pEnd = text + length;
+  sa_uint32_t used = 1;
+
+  pChunks[0].pText = text;
+
+  // Only text from share boundary to next Function line is read, so splitting does not grow with text size
+  for(sa_uint32_t i = 1; i < chunkCount; i++) {
+    const char* p = text + (sa_uint32_t)((sa_uint64_t)length * i / chunkCount);
+
+    if(p <= pChunks[used - 1].pText)
+      continue;
+
+    p = sa__nextLine(p - 1, pEnd);
+
+    while(p < pEnd) {
+      const char* lineStart = p;
+      sa_uint32_t mnemonicLength = 0;
+      const char* mnemonic = sa__nextLineToken(&p, pEnd, &mnemonicLength);
+
+      if(sa__tokenEquals(mnemonic, mnemonicLength, "Function")) {
+        p = lineStart;
+
+        break;
+      }
+
+      p = sa__nextLine(p, pEnd);
+    }
+
+    if(p >= pEnd)
+      break;
+
+    if(p == pChunks[used - 1].pText)
+      continue;
+
+    pChunks[used - 1].length = p - pChunks[used - 1].pText;
+    pChunks[used].pText = p;
+    used++;
+  }
+
+  pChunks[used - 1].length = pEnd - pChunks[used - 1].pText;
+
+  return used;
+}
+
+/**
+ * @brief Counts lines of chunk and gathers its numeric types, constants of one chunk can use types from another one
+ * 
+ * @param pChunk 
+ */
+static void sa__scanParallelChunk(sa__parallelChunk_t* pChunk) {
+  const char* const pEnd = pChunk->pText + pChunk->length;
+  const char* p = pChunk->pText;
+
+  pChunk->lineBreaks = sa__countClass(p, pEnd, SA_CHAR_NEWLINE);
+
+  while(p < pEnd) {
+    const char* lineStart = p;
+    sa_uint32_t mnemonicLength = 0;
+    const char* mnemonic = sa__nextLineToken(&p, pEnd, &mnemonicLength);
+
+    if(sa__tokenEquals(mnemonic, mnemonicLength, "TypeInt") || sa__tokenEquals(mnemonic, mnemonicLength, "TypeFloat")) {
+      const sa_bool isInt = mnemonic[4] == 'I';
+      sa_uint32_t nameLength = 0;
+      sa_uint32_t widthLength = 0;
+      sa_uint32_t signLength = 0;
+      const char* name = sa__nextLineToken(&p, pEnd, &nameLength);
+      const char* width = sa__nextLineToken(&p, pEnd, &widthLength);
+      const char* sign = sa__nextLineToken(&p, pEnd, &signLength);
+      sa__number_t number;
+
+      if(nameLength > 1 && name[0] == '%' && sa__parseNumber(width, widthLength, &number) && number.kind == saNumberKind_Integer) {
+        const sa_uint32_t index = sa__pushSpirvId(&pChunk->types, name + 1, nameLength - 1, lineStart - pChunk->parallel.pText);
+
+        pChunk->types.pIds[index].numericKind = isInt ? saNumberKind_Integer : saNumberKind_Float;
+        pChunk->types.pIds[index].numericWidth = (sa_uint8_t)number.integer;
+        pChunk->types.pIds[index].numericSigned = !isInt || (signLength > 0 && sa__stringToInt(sign, signLength) != 0);
+      }
+    }
+
+    p = sa__nextLine(p, pEnd);
+  }
+}
+
+/**
+ * @brief Assembles one chunk with its own context, id table and assembly, so nothing is shared with other chunks
+ * 
+ * @param pChunk 
+ */
+static void sa__assembleParallelChunk(sa__parallelChunk_t* pChunk) {
+  sa_assembler_t* pAssembler = &pChunk->assembler;
+
+  sa__setMemory(pAssembler, 0, sizeof(*pAssembler));
+
+  pAssembler->pCtx = &pChunk->ctx;
+  pAssembler->pAssembly = &pChunk->assembly;
+  pAssembler->line = pChunk->line;
+  pAssembler->ids.pParallel = &pChunk->parallel;
+
+  sa__assembleLines(pAssembler, pChunk->pText, pChunk->length);
+}
+
+/**
+ * @brief Copies chunk into space merge reserved for it in target assembly and swaps chunk ids for global ones. Chunk is freed afterwards
+ * 
+ * @param pChunk 
+ */
+static void sa__copyParallelChunk(sa__parallelChunk_t* pChunk) {
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    const sa__assemblySection_t* pSource = &pChunk->assembly.section[sect];
+    sa__assemblySection_t* pSection = &pChunk->pTarget->section[sect];
+
+    for(sa_uint32_t i = 0; i < pSource->instCount; i++)
+      pSection->pInstOffsets[pChunk->instBase[sect] + i] = pSource->pInstOffsets[i] + pChunk->wordBase[sect];
+
+    if(pSource->wordCount > 0)
+      sa__copyMemory(pSource->pWords, &pSection->pWords[pChunk->wordBase[sect]], pSource->wordCount * sizeof(sa_uint32_t));
+  }
+
+  for(sa_uint32_t i = 0; i < pChunk->parallel.idWordCount; i++) {
+    const sa__idWordRef_t ref = pChunk->parallel.pIdWords[i];
+    sa_uint32_t* pWord = &pChunk->pTarget->section[ref.section].pWords[pChunk->wordBase[ref.section] + ref.offset];
+
+    *pWord = SA_CONVERT(pChunk->pIdMap[SA_CONVERT(*pWord)]);
+  }
+
+  sa__freeSpirvIdTable(&pChunk->assembler.ids);
+  sa__freeSpirvIdTable(&pChunk->types);
+  sa_freeAssembly(&pChunk->assembly);
+  sa_freeContext(&pChunk->ctx);
+  sa_free(pChunk->parallel.pIdWords);
+  sa_free(pChunk->pIdMap);
+}
+
+/**
+ * @brief Runs stage of chunk, passed to sa__runOnThreads
+ * 
+ * @param pItem chunk
+ */
+static void sa__runParallelChunkStage(void* pItem) {
+  sa__parallelChunk_t* pChunk = (sa__parallelChunk_t*)pItem;
+
+  pChunk->pfnStage(pChunk);
+}
+
+/**
+ * @brief Runs stage for every chunk, on own thread each when SA_ENABLE_THREADS is defined
+ * 
+ * @param pChunks 
+ * @param chunkCount 
+ * @param pfnStage 
+ */
+static void sa__runParallelChunks(sa__parallelChunk_t* pChunks, sa_uint32_t chunkCount, void (*pfnStage)(sa__parallelChunk_t* pChunk)) {
+  for(sa_uint32_t i = 0; i < chunkCount; i++)
+    pChunks[i].pfnStage = pfnStage;
+
+  sa__runOnThreads(sa__runParallelChunkStage, pChunks, sizeof(sa__parallelChunk_t), chunkCount);
+}
+
+/**
+ * @brief Gives chunk ids global ids and places chunk after everything merged before it. Chunk ids are mapped in order they were first used in chunk, so merging chunks in text order gives the same ids as assembling whole text at once. Words are copied later by sa__copyParallelChunk
+ * 
+ * @param pAssembler assembler of whole text
+ * @param pChunk 
+ * @param pInstCount instruction count of every section, advanced past the chunk
+ * @param pWordCount word count of every section, advanced past the chunk
+ */
+static void sa__mergeParallelChunk(sa_assembler_t* pAssembler, sa__parallelChunk_t* pChunk, sa_uint32_t* pInstCount, sa_uint32_t* pWordCount) {
+  sa_context_t* pCtx = pAssembler->pCtx;
+  sa__spirvIdTable_t* pIds = &pChunk->assembler.ids;
+
+  // Diagnostics reach sink of the context here, in text order
+  sa__moveDiagnostics(&pCtx->diagnostics, &pChunk->ctx.diagnostics);
+
+  // Chunk ids are 1..idCount in order of creation, same as order of entries
+  pChunk->pIdMap = (sa_uint32_t*)sa_calloc(pIds->idCount + 1, sizeof(sa_uint32_t));
+
+  for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
+    const char* name = sa__poolString(&pIds->names, pIds->pIds[i].textId);
+
+    pChunk->pIdMap[pIds->pIds[i].binaryId] = sa__getOrCreateSpirvIdLength(pCtx, &pAssembler->ids, name, sa__lengthString(name));
+  }
+
+  pChunk->pTarget = pAssembler->pAssembly;
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    pChunk->instBase[sect] = pInstCount[sect];
+    pChunk->wordBase[sect] = pWordCount[sect];
+    pInstCount[sect] += pChunk->assembly.section[sect].instCount;
+    pWordCount[sect] += pChunk->assembly.section[sect].wordCount;
+  }
+}
+
+/**
+ * @brief Assembles text split into chunks at function boundaries, every chunk on own thread when SA_ENABLE_THREADS is defined. Result is the same as from sa_assembleSPIRVN. Only id mapping runs on one thread, scanning, assembling and copying of chunks run on all of them
+ * 
+ * @param pCtx context, SA_NULL for default one
+ * @param spirvBasicAssembly text to process, does not need to be null terminated
+ * @param length length of text in bytes
+ * @param pAssembly assembly to fill
+ * @param threadCount maximal amount of chunks (and threads) to use
+ */
+static void sa_assembleSPIRVParallel(sa_context_t* pCtx, const char* spirvBasicAssembly, sa_uint32_t length, sa_assembly_t* pAssembly, sa_uint32_t threadCount) {
+  if(threadCount < 2) {
+    sa_assembleSPIRVN(pCtx, spirvBasicAssembly, length, pAssembly);
+
+    return;
+  }
+
+  sa__parallelChunk_t* pChunks = (sa__parallelChunk_t*)sa_calloc(threadCount, sizeof(sa__parallelChunk_t));
+  sa__spirvIdTable_t types = {0};
+  sa_uint32_t* pNextTypes = SA_NULL;
+  sa_uint32_t nextTypeCapacity = 0;
+
+  const sa_uint32_t chunkCount = sa__splitParallelChunks(spirvBasicAssembly, length, pChunks, threadCount);
+
+  for(sa_uint32_t i = 0; i < chunkCount; i++)
+    pChunks[i].parallel.pText = spirvBasicAssembly;
+
+  sa__runParallelChunks(pChunks, chunkCount, sa__scanParallelChunk);
+
+  // Types are gathered in text order, same as one pass over whole text would do
+  for(sa_uint32_t i = 0; i < chunkCount; i++) {
+    const sa__spirvIdTable_t* pChunkTypes = &pChunks[i].types;
+
+    pChunks[i].line = i == 0 ? 1 : pChunks[i - 1].line + pChunks[i - 1].lineBreaks;
+
+    for(sa_uint32_t j = 0; j < pChunkTypes->idCount; j++) {
+      const char* name = sa__poolString(&pChunkTypes->names, pChunkTypes->pIds[j].textId);
+      sa_uint32_t previous = sa__findSpirvIdIndex(&types, name, sa__lengthString(name));
+      const sa_uint32_t index = sa__pushSpirvId(&types, name, sa__lengthString(name), pChunkTypes->pIds[j].binaryId);
+
+      pNextTypes = (sa_uint32_t*)sa__growArray(pNextTypes, sizeof(sa_uint32_t), &nextTypeCapacity, types.idCount, SA_NULL);
+      pNextTypes[index] = SA_UINT32_MAX;
+
+      if(previous != SA_UINT32_MAX) {
+        while(pNextTypes[previous] != SA_UINT32_MAX)
+          previous = pNextTypes[previous];
+
+        pNextTypes[previous] = index;
+      }
+
+      types.pIds[index].numericKind = pChunkTypes->pIds[j].numericKind;
+      types.pIds[index].numericWidth = pChunkTypes->pIds[j].numericWidth;
+      types.pIds[index].numericSigned = pChunkTypes->pIds[j].numericSigned;
+    }
+
+    // Chunk never records more than the whole text could
+    sa_initContext(&pChunks[i].ctx);
+    pChunks[i].ctx.diagnostics.limit = sa__resolveContext(pCtx)->diagnostics.limit;
+  }
+
+  for(sa_uint32_t i = 0; i < chunkCount; i++) {
+    pChunks[i].parallel.pTypes = &types;
+    pChunks[i].parallel.pNextTypes = pNextTypes;
+  }
+
+  sa__runParallelChunks(pChunks, chunkCount, sa__assembleParallelChunk);
+
+  sa_assembler_t assembler;
+  sa_uint32_t instCount[saSectionType_COUNT];
+  sa_uint32_t wordCount[saSectionType_COUNT];
+
+  sa_assembleBegin(pCtx, &assembler, pAssembly);
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    instCount[sect] = pAssembly->section[sect].instCount;
+    wordCount[sect] = pAssembly->section[sect].wordCount;
+  }
+
+  // Chunks go in text order, that keeps ids, instructions and errors in the same order as in sa_assembleSPIRVN
+  for(sa_uint32_t i = 0; i < chunkCount; i++)
+    sa__mergeParallelChunk(&assembler, &pChunks[i], instCount, wordCount);
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++)
+    sa_reserveSection(pAssembly, sect, instCount[sect], wordCount[sect]);
+
+  sa__runParallelChunks(pChunks, chunkCount, sa__copyParallelChunk);
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    pAssembly->section[sect].instCount = instCount[sect];
+    pAssembly->section[sect].wordCount = wordCount[sect];
+  }
+
+  sa_assembleEnd(&assembler);
+
+  sa__freeSpirvIdTable(&types);
+  sa_free(pNextTypes);
+  sa_free(pChunks);
+}
+
+/**
+ * @brief Called by sa_bakeSPIRVToSink with every baked chunk (header, then one chunk per section)
+ * 
+ * @param pUserData user pointer passed to sa_bakeSPIRVToSink
+ * @param pData chunk of binary, valid only during the call
+ * @param size chunk size in bytes
+ * @return sa_bool SA_FALSE stops baking
+ */
+typedef sa_bool (*sa_bakeSink_t)(void* pUserData, const sa_uint8_t* pData, sa_uint32_t size);
+
+static void sa__bakeHeader(const sa_assembly_t* const pAssembly, sa_uint32_t* pHeaderOut) {
+  // Always converted to little endian
+  pHeaderOut[0] = SA_CONVERT(SA_SPIRV_MAGIC_NUMBER);
+  pHeaderOut[1] = SA_CONVERT(SA_SPIRV_VERSION);
+  pHeaderOut[2] = SA_CONVERT(SA_SPIRV_GENERATOR_ID);
+  pHeaderOut[3] = SA_CONVERT(pAssembly->header.bounds);
+  pHeaderOut[4] = SA_CONVERT(pAssembly->header.schema);
+}
+
+/**
+ * @brief Size of baked binary in bytes
+ * 
+ * @param pAssembly 
+ * @return sa_uint32_t 
+ */
+static sa_uint32_t sa__bakedSize(const sa_assembly_t* const pAssembly) {
+  // Sections are already encoded so only their sizes are needed
+  sa_uint32_t sbinSize = (sizeof(sa__assemblyHeader_t) / sizeof(sa_uint32_t));
+
+  for(sa_uint32_t sectId = 0; sectId < saSectionType_COUNT; sectId++) {
+    sbinSize += pAssembly->section[sectId].wordCount;
+  }
+
+  return sbinSize * sizeof(sa_uint32_t);
+}
+
+/**
+ * @brief Bakes assembly into memory owned by caller (mapped file, staging memory etc.)
+ * 
+ * @param pAssembly assembly to bake
+ * @param pBuffer where binary goes, can be SA_NULL to only query size
+ * @param capacity size of pBuffer in bytes
+ * @param pNeededOut size of whole binary in bytes, can be SA_NULL
+ * @return sa_bool SA_TRUE if whole binary was written, SA_FALSE if buffer is missing or too small
+ */
+static sa_bool sa_bakeSPIRVInto(sa_context_t* pCtx, const sa_assembly_t* const pAssembly, sa_uint8_t* pBuffer, sa_uint32_t capacity, sa_uint32_t* pNeededOut) {
+  pCtx = sa__resolveContext(pCtx);
+
+  if(!pAssembly) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "No assembly");
+
+    return SA_FALSE;
+  }
+
+  const sa_uint32_t needed = sa__bakedSize(pAssembly);
+
+  if(pNeededOut)
+    *pNeededOut = needed;
+
+  if(!pBuffer || capacity < needed)
+    return SA_FALSE;
+
+  sa_uint32_t header[sizeof(sa__assemblyHeader_t) / sizeof(sa_uint32_t)];
+  sa__bakeHeader(pAssembly, header);
+  sa__copyMemory(header, pBuffer, sizeof(header));
+
+  // Copy every section as a whole right after previous one
+  sa_uint32_t offset = sizeof(header);
+  // Word copy needs aligned destination, caller memory does not have to be
+  const sa_bool aligned = ((sa_uint64_t)pBuffer & (sizeof(sa_uint32_t) - 1)) == 0;
+
+  for(sa_uint32_t sectId = 0; sectId < saSectionType_COUNT; sectId++) {
+    const sa__assemblySection_t* const pSect = &pAssembly->section[sectId];
+
+    if(aligned)
+      sa__copyWords(pSect->pWords, sa_ptr32(&pBuffer[offset]), pSect->wordCount);
+    else
+      sa__copyMemory(pSect->pWords, &pBuffer[offset], pSect->wordCount * sizeof(sa_uint32_t));
+
+    offset += pSect->wordCount * sizeof(sa_uint32_t);
+  }
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Bakes assembly straight into a sink without any intermediate buffer
+ * 
+ * @param pAssembly assembly to bake
+ * @param sink called with header and then with every non empty section
+ * @param pUserData passed to every sink call
+ * @return sa_bool SA_FALSE if sink stopped baking
+ */
+static sa_bool sa_bakeSPIRVToSink(sa_context_t* pCtx, const sa_assembly_t* const pAssembly, sa_bakeSink_t sink, void* pUserData) {
+  pCtx = sa__resolveContext(pCtx);
+
+  if(!pAssembly || !sink) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "No assembly or sink");
+
+    return SA_FALSE;
+  }
+
+  sa_uint32_t header[sizeof(sa__assemblyHeader_t) / sizeof(sa_uint32_t)];
+  sa__bakeHeader(pAssembly, header);
+
+  if(!sink(pUserData, sa_ptr8(header), sizeof(header)))
+    return SA_FALSE;
+
+  for(sa_uint32_t sectId = 0; sectId < saSectionType_COUNT; sectId++) {
+    const sa__assemblySection_t* const pSect = &pAssembly->section[sectId];
+
+    if(pSect->wordCount == 0)
+      continue;
+
+    if(!sink(pUserData, sa_ptr8(pSect->pWords), pSect->wordCount * sizeof(sa_uint32_t)))
+      return SA_FALSE;
+  }
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Bakes assembly into actual binary data
+ * 
+ * @param pAssembly assembly to bake
+ * @param pBinarySizeOut size of binary table 
+ * @return sa_binary pointer to binary data itself
+ */
+static sa_uint8_t* sa_bakeSPIRV(sa_context_t* pCtx, const sa_assembly_t* const pAssembly, sa_uint32_t* pBinarySizeOut) {
+  pCtx = sa__resolveContext(pCtx);
+
+  if(!pAssembly) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "No assembly");
+
+    return SA_NULL;
+  }
+
+  if(!pBinarySizeOut) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "No size output");
+
+    return SA_NULL;
+  }
+
+  sa__clearDiagnostics(&pCtx->diagnostics);
+
+  // Size is known up front, so binary is allocated once
+  *pBinarySizeOut = sa__bakedSize(pAssembly);
+
+  sa_uint8_t* sbin = (sa_uint8_t*)sa_malloc(*pBinarySizeOut);
+
+  sa_bakeSPIRVInto(pCtx, pAssembly, sbin, *pBinarySizeOut, SA_NULL);
+
+  return sbin;
+}
+
+// Memory sa_assembleToBinary works in, can be kept between files so it is allocated once
+typedef struct sa__binaryScratch_s {
+  // Only baked, words of every section but Functions are reused
+  sa_assembly_t assembly;
+  sa__spirvIdTable_t ids;
+} sa__binaryScratch_t;
+
+static void sa__freeBinaryScratch(sa__binaryScratch_t* pScratch) {
+  sa_freeAssembly(&pScratch->assembly);
+  sa__freeSpirvIdTable(&pScratch->ids);
+}
+
+/**
+ * @brief sa_assembleToBinary working in given scratch memory
+ * 
+ * @param pCtx context, must not be SA_NULL
+ * @param spirvBasicAssembly 
+ * @param length 
+ * @param pScratch scratch memory, reset at start
+ * @param pBinarySizeOut 
+ * @return sa_uint8_t* 
+ */
+static sa_uint8_t* sa__assembleToBinaryScratch(sa_context_t* pCtx, const char* spirvBasicAssembly, sa_uint32_t length, sa__binaryScratch_t* pScratch, sa_uint32_t* pBinarySizeOut) {
+  sa_assembly_t* pAssembly = &pScratch->assembly;
+  sa_assembler_t assembler;
+
+  pAssembly->bakeOnly = SA_TRUE;
+
+  for(sa_uint32_t sectId = 0; sectId < saSectionType_COUNT; sectId++) {
+    pAssembly->section[sectId].wordCount = 0;
+    pAssembly->section[sectId].instCount = 0;
+  }
+
+  sa_assembleBegin(pCtx, &assembler, pAssembly);
+
+  const sa_uint32_t lineCount = 1 + sa__countClass(spirvBasicAssembly, spirvBasicAssembly + length, SA_CHAR_NEWLINE);
+
+  // Table of previous file is taken over instead of built from nothing, unless it is so much bigger that clearing it costs more
+  if(pScratch->ids.nameSlotCount / 8 > lineCount)
+    sa__freeSpirvIdTable(&pScratch->ids);
+  else
+    sa__resetSpirvIdTable(&pScratch->ids);
+
+  assembler.ids = pScratch->ids;
+
+  // Heap words are not touched until written, so generous reserve only costs address space
+  sa__reserveSpirvIds(&assembler.ids, lineCount);
+  sa_reserveSection(pAssembly, saSectionType_Functions, lineCount, lineCount * 4);
+
+  sa__assembleLines(&assembler, spirvBasicAssembly, length);
+  sa__finishAssembly(&assembler);
+
+  pScratch->ids = assembler.ids;
+
+  *pBinarySizeOut = sa__bakedSize(pAssembly);
+
+  // Function bodies are the bulk of the module and are last in it, so their words become the binary and only the rest is copied in front of them
+  sa__assemblySection_t* pFunctions = &pAssembly->section[saSectionType_Functions];
+  const sa_uint32_t functionWords = pFunctions->wordCount;
+  const sa_uint32_t prefixWords = *pBinarySizeOut / sizeof(sa_uint32_t) - functionWords;
+  sa_uint32_t* pBinary = (sa_uint32_t*)sa_realloc(pFunctions->pWords, *pBinarySizeOut);
+
+  pFunctions->pWords = SA_NULL;
+  pFunctions->wordCount = 0;
+  pFunctions->wordCapacity = 0;
+
+  sa__moveWords(pBinary, pBinary + prefixWords, functionWords);
+
+  sa__bakeHeader(pAssembly, pBinary);
+
+  sa_uint32_t offset = sizeof(sa__assemblyHeader_t) / sizeof(sa_uint32_t);
+
+  for(sa_uint32_t sectId = 0; sectId < saSectionType_Functions; sectId++) {
+    sa__copyWords(pAssembly->section[sectId].pWords, &pBinary[offset], pAssembly->section[sectId].wordCount);
+    offset += pAssembly->section[sectId].wordCount;
+  }
+
+  return sa_ptr8(pBinary);
+}
+
+/**
+ * @brief Assembles text straight into binary, same bytes as sa_assembleSPIRVN followed by sa_bakeSPIRV. No assembly is kept, so instruction offsets are skipped and function bodies are grown in the binary allocation itself
+ *
+ * @param pCtx context, SA_NULL for default one. Unlike sa_bakeSPIRV assembling errors are kept
+ * @param spirvBasicAssembly text to process, does not need to be null terminated
+ * @param length length of text in bytes
+ * @param pBinarySizeOut size of binary in bytes
+ * @return sa_uint8_t* binary, free with sa_freeSPIRV
+ */
+static sa_uint8_t* sa_assembleToBinary(sa_context_t* pCtx, const char* spirvBasicAssembly, sa_uint32_t length, sa_uint32_t* pBinarySizeOut) {
+  pCtx = sa__resolveContext(pCtx);
+
+  if(!pBinarySizeOut) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "No size output");
+
+    return SA_NULL;
+  }
+
+  sa__binaryScratch_t scratch = {0};
+  sa_uint8_t* pBinary = sa__assembleToBinaryScratch(pCtx, spirvBasicAssembly, length, &scratch, pBinarySizeOut);
+
+  sa__freeBinaryScratch(&scratch);
+
+  return pBinary;
 }
 
 //
-// Error handling
+// Batch assembly
 //
 
-static void sa__clearErrorMessages() {
-  for(sa_uint32_t i = 0; i < __gAssemblerErrorMessages.messagesAmount; i++) {
-    sa_free(__gAssemblerErrorMessages.pMessages[i]);
-    __gAssemblerErrorMessages.pMessages[i] = SA_NULL;
-  }
+typedef struct sa_batchInput_s {
+  // Text to assemble, does not need to be null terminated
+  const char* pText;
+  sa_uint32_t length;
+} sa_batchInput_t;
+
+typedef struct sa_batchOutput_s {
+  // Binary of the input, free with sa_freeBatchOutputs
+  sa_uint8_t* pBinary;
+  sa_uint32_t binarySize;
+  // Errors of this input only, sink of context is not called for them
+  sa_diagnostics_t errors;
+} sa_batchOutput_t;
+
+typedef struct sa__batchTask_s {
+  sa_uint32_t length;
+  sa_uint32_t index;
+} sa__batchTask_t;
+
+// Shared by all workers, only nextTask changes while they run
+typedef struct sa__batch_s {
+  const sa_batchInput_t* pInputs;
+  sa_batchOutput_t* pOutputs;
+  // Longest input first, so long shaders do not end up last on one worker
+  sa__batchTask_t* pTasks;
+  sa_uint32_t taskCount;
+  sa_uint32_t nextTask;
+#ifdef SA_ENABLE_THREADS
+#if defined(_WIN32)
+  CRITICAL_SECTION lock;
+#else
+  pthread_mutex_t lock;
+#endif
+#endif
+} sa__batch_t;
+
+// Context and scratch memory of one worker, reused for every input it takes
+typedef struct sa__batchWorker_s {
+  sa__batch_t* pBatch;
+  sa_context_t ctx;
+  sa__binaryScratch_t scratch;
+} sa__batchWorker_t;
+
+static int sa__compareBatchTasks(const void* pLeft, const void* pRight) {
+  const sa__batchTask_t* pA = (const sa__batchTask_t*)pLeft;
+  const sa__batchTask_t* pB = (const sa__batchTask_t*)pRight;
 
-  sa_free(__gAssemblerErrorMessages.pMessages);
-  __gAssemblerErrorMessages.pMessages = SA_NULL;
-  __gAssemblerErrorMessages.messagesAmount = 0;
+  if(pA->length != pB->length)
+    return pA->length > pB->length ? -1 : 1;
+
+  return pA->index < pB->index ? -1 : (pA->index > pB->index);
 }
 
-static void sa__errMsg(const char* fmt, ...) {
-  sa_uint32_t count = 0;
+/**
+ * @brief Takes next task of the batch
+ * 
+ * @param pBatch 
+ * @return sa_uint32_t task index or SA_UINT32_MAX when all are taken
+ */
+static sa_uint32_t sa__nextBatchTask(sa__batch_t* pBatch) {
+  sa_uint32_t task = SA_UINT32_MAX;
+
+#ifdef SA_ENABLE_THREADS
+#if defined(_WIN32)
+  EnterCriticalSection(&pBatch->lock);
+#else
+  pthread_mutex_lock(&pBatch->lock);
+#endif
+#endif
 
-  for(sa_uint32_t i = 0; i < sa__lengthString(fmt); i++) {
-    if(fmt[i] == '%')
-    count++;
+  if(pBatch->nextTask < pBatch->taskCount)
+    task = pBatch->nextTask++;
+
+#ifdef SA_ENABLE_THREADS
+#if defined(_WIN32)
+  LeaveCriticalSection(&pBatch->lock);
+#else
+  pthread_mutex_unlock(&pBatch->lock);
+#endif
+#endif
+
+  return task;
+}
+
+/**
+ * @brief Assembles inputs until none is left, passed to sa__runOnThreads
+ * 
+ * @param pItem worker
+ */
+static void sa__runBatchWorker(void* pItem) {
+  sa__batchWorker_t* pWorker = (sa__batchWorker_t*)pItem;
+  sa__batch_t* pBatch = pWorker->pBatch;
+  sa_uint32_t task = 0;
+
+  while((task = sa__nextBatchTask(pBatch)) != SA_UINT32_MAX) {
+    const sa_uint32_t index = pBatch->pTasks[task].index;
+    const sa_batchInput_t* pInput = &pBatch->pInputs[index];
+    sa_batchOutput_t* pOutput = &pBatch->pOutputs[index];
+
+    sa__clearDiagnostics(&pWorker->ctx.diagnostics);
+
+    // Empty input without text is empty module, same as from sa_assembleToBinary
+    if(pInput->pText || pInput->length == 0)
+      pOutput->pBinary = sa__assembleToBinaryScratch(&pWorker->ctx, pInput->pText, pInput->length, &pWorker->scratch, &pOutput->binarySize);
+    else
+      sa__errMsg(&pWorker->ctx, saDiagnostic_InvalidArgument, "No text for input %u", index);
+
+    // Diagnostics are handed over, worker starts next input with none
+    pOutput->errors = pWorker->ctx.diagnostics;
+    pWorker->ctx.diagnostics.pRecords = SA_NULL;
+    pWorker->ctx.diagnostics.recordCapacity = 0;
+    pWorker->ctx.diagnostics.pStrings = SA_NULL;
+    pWorker->ctx.diagnostics.stringsCapacity = 0;
+    pWorker->ctx.diagnostics.pMessage = SA_NULL;
+    pWorker->ctx.diagnostics.messageCapacity = 0;
   }
+}
 
-  __gAssemblerErrorMessages.messagesAmount++;
-  __gAssemblerErrorMessages.pMessages = (char**)sa_realloc(__gAssemblerErrorMessages.pMessages, sizeof(char*) * __gAssemblerErrorMessages.messagesAmount);
-  // If you look closely at how this is handled, it is so unoptimally done
-  __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_malloc(sizeof(char));
-  
-  va_list args;
-  va_start(args, count);
-  
-  sa_uint32_t msgSize = 0;
-
-  for(sa_uint32_t i = 0; i < sa__lengthString(fmt); i++) {
-    if(fmt[i] == '%') {
-      msgSize++;
-
-      switch(fmt[i + 1]) {
-      // Char
-      case 'c': {
-        msgSize++;
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - 1] = va_arg(args, char);
-        break;
-      }
+/**
+ * @brief Assembles many texts into binaries on a fixed pool of workers, each with own context and scratch memory. Longest inputs are started first, outputs are in input order. Without SA_ENABLE_THREADS inputs are assembled one after another
+ * 
+ * @param pCtx context for errors of the call itself, SA_NULL for default one
+ * @param pInputs 
+ * @param inputCount 
+ * @param pOutputs array of inputCount outputs, free with sa_freeBatchOutputs
+ * @param threadCount amount of workers
+ * @return sa_bool SA_FALSE if any input has errors, they are in its output
+ */
+static sa_bool sa_assembleBatch(sa_context_t* pCtx, const sa_batchInput_t* pInputs, sa_uint32_t inputCount, sa_batchOutput_t* pOutputs, sa_uint32_t threadCount) {
+  pCtx = sa__resolveContext(pCtx);
 
-      // Int
-      case 'd': {
-        sa_int32_t numberInt = va_arg(args, sa_int32_t); 
-        char* number = sa__intToString(numberInt);
-        sa_uint32_t numLength = sa__lengthString(number);
+  if(inputCount > 0 && (!pInputs || !pOutputs)) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "No inputs or outputs");
 
-        msgSize += numLength;
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-        sa__copyMemory(number, &__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - numLength - 1], numLength);
-        break;
-      }
+    return SA_FALSE;
+  }
 
-      // Float
-      case 'f': {
-        float fnumberFloat = va_arg(args, float);
-        char* fnumber = sa__floatToString(fnumberFloat, 6);
-        sa_uint32_t fnumLength = sa__lengthString(fnumber);
+  if(inputCount == 0)
+    return SA_TRUE;
 
-        msgSize += fnumLength;
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-        sa__copyMemory(fnumber, &__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - fnumLength - 1], fnumLength);
-        break;
-      }
+  sa__setMemory(pOutputs, 0, inputCount * sizeof(sa_batchOutput_t));
 
-      // String
-      case 's': {
-        char* string = va_arg(args, char*);
-        sa_uint32_t length = sa__lengthString(string);
+  sa__batch_t batch;
 
-        msgSize += length;
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-        sa__copyMemory(string, &__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - length - 1], length);
-        break;
-      }
+  sa__setMemory(&batch, 0, sizeof(batch));
+  batch.pInputs = pInputs;
+  batch.pOutputs = pOutputs;
+  batch.taskCount = inputCount;
+  batch.pTasks = (sa__batchTask_t*)sa_malloc(inputCount * sizeof(sa__batchTask_t));
 
-      // Hex
-      case 'x': {
-        sa_uint32_t hnumberUint = va_arg(args, sa_uint32_t); 
-        char* hnumber = sa__hexToString(hnumberUint);
-        sa_uint32_t hnumLength = sa__lengthString(hnumber);
+  for(sa_uint32_t i = 0; i < inputCount; i++) {
+    batch.pTasks[i].length = pInputs[i].length;
+    batch.pTasks[i].index = i;
+  }
 
-        msgSize += hnumLength;
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-        sa__copyMemory(hnumber, &__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - hnumLength - 1], hnumLength);
-        break;
-      }
+  qsort(batch.pTasks, inputCount, sizeof(sa__batchTask_t), sa__compareBatchTasks);
 
-      // The percent chacarter
-      case '%': {
-        msgSize++;
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-        __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - 1] = '%';
-        break;
-      }
+#ifdef SA_ENABLE_THREADS
+  const sa_uint32_t workerCount = threadCount < 1 ? 1 : (threadCount > inputCount ? inputCount : threadCount);
 
-      default: {
-        break;
-      }
-      }
+#if defined(_WIN32)
+  InitializeCriticalSection(&batch.lock);
+#else
+  pthread_mutex_init(&batch.lock, SA_NULL);
+#endif
+#else
+  // Workers would run one after another anyway
+  (void)threadCount;
+  const sa_uint32_t workerCount = 1;
+#endif
 
-      i += 2;
-      // This needs to be here
-      msgSize--;
-    }
+  sa__batchWorker_t* pWorkers = (sa__batchWorker_t*)sa_calloc(workerCount, sizeof(sa__batchWorker_t));
 
-    msgSize++;
-    __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-    __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - 1] = fmt[i];
+  for(sa_uint32_t i = 0; i < workerCount; i++) {
+    pWorkers[i].pBatch = &batch;
+    sa_initContext(&pWorkers[i].ctx);
+    pWorkers[i].ctx.diagnostics.limit = pCtx->diagnostics.limit;
   }
 
-  msgSize++;
-  __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1] = (char*)sa_realloc(__gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1], sizeof(char) * msgSize);
-  __gAssemblerErrorMessages.pMessages[__gAssemblerErrorMessages.messagesAmount - 1][msgSize - 1] = 0;
+  sa__runOnThreads(sa__runBatchWorker, pWorkers, sizeof(sa__batchWorker_t), workerCount);
 
-  va_end(args);
+  for(sa_uint32_t i = 0; i < workerCount; i++) {
+    sa__freeBinaryScratch(&pWorkers[i].scratch);
+    sa_freeContext(&pWorkers[i].ctx);
+  }
+
+#ifdef SA_ENABLE_THREADS
+#if defined(_WIN32)
+  DeleteCriticalSection(&batch.lock);
+#else
+  pthread_mutex_destroy(&batch.lock);
+#endif
+#endif
+
+  sa_free(pWorkers);
+  sa_free(batch.pTasks);
+
+  for(sa_uint32_t i = 0; i < inputCount; i++) {
+    if(pOutputs[i].errors.errorCount > 0)
+      return SA_FALSE;
+  }
+
+  return SA_TRUE;
+}
+
+/**
+ * @brief Frees binaries and errors of every output of sa_assembleBatch
+ * 
+ * @param pOutputs 
+ * @param outputCount 
+ */
+static void sa_freeBatchOutputs(sa_batchOutput_t* pOutputs, sa_uint32_t outputCount) {
+  for(sa_uint32_t i = 0; i < outputCount; i++) {
+    sa_free(pOutputs[i].pBinary);
+
+    sa__freeDiagnostics(&pOutputs[i].errors);
+    sa__setMemory(&pOutputs[i], 0, sizeof(pOutputs[i]));
+  }
 }
 
 //
-// SPIR-V ID gen
+// Incremental session
 //
 
-static sa_uint32_t sa__genId() {
-  return __gIdGeneratorHoldValue++;
-}
+// Section of line that did not become instruction (comment, empty or failed line)
+#define SA_SESSION_NO_SECTION 0xFF
+
+// One line of session text and instruction it became. Lines after the gap of line records keep textOffset, wordOffset and firstId
+// counted back from the end of text, section and ids, so edits before them do not have to touch them
+typedef struct sa__sessionLine_s {
+  // Offset of line start inside session text
+  sa_uint32_t textOffset;
+  // Instruction of the line inside its section
+  sa_uint32_t wordOffset;
+  sa_uint32_t wordCount;
+  // Lowest id line can use first, ids are numbered in order they are first used in text
+  sa_uint32_t firstId;
+  sa_uint8_t section;
+  // Assembler state before the line
+  sa_bool insideFn;
+  // Line opens or closes function, declares numeric type or became more than one instruction, edits touching it assemble whole text
+  sa_bool structural;
+  sa_bool failed;
+} sa__sessionLine_t;
+
+// Assembly kept together with its text, edits of text only reassemble lines they touch
+typedef struct sa_session_s {
+  // Always matches current text, patched by every edit
+  sa_assembly_t assembly;
+  // Holds context and id table between edits
+  sa_assembler_t assembler;
+  // Copy of the text owned by session, with gap of textGapSize bytes at textGap where last edit ended (use sa_sessionText to read it)
+  char* pText;
+  sa_uint32_t length;
+  sa_uint32_t textCapacity;
+  sa_uint32_t textGap;
+  sa_uint32_t textGapSize;
+  // Line records with gap of lineGapSize records at lineGap, right after lines of last edit
+  sa__sessionLine_t* pLines;
+  sa_uint32_t lineCount;
+  sa_uint32_t lineCapacity;
+  sa_uint32_t lineGap;
+  sa_uint32_t lineGapSize;
+  // Lines of edit before they replace old ones, with their instructions in scratch
+  sa__sessionLine_t* pEditLines;
+  sa_uint32_t editLineCapacity;
+  sa_assembly_t scratch;
+  // Instructions that came from lines in every section
+  sa_uint32_t sectionLines[saSectionType_COUNT];
+  sa_uint32_t failedLines;
+  // Names of ids go after every Name section instruction from lines
+  sa_uint32_t idNamesOffset;
+} sa_session_t;
+
+/**
+ * @brief Checks if line is Function, FunctionEnd, TypeInt or TypeFloat. Those change how lines after them are assembled, so edits touching them assemble whole text again
+ * 
+ * @param p line start
+ * @param pEnd line end
+ * @return sa_bool 
+ */
+static sa_bool sa__isStructuralLine(const char* p, const char* pEnd) {
+  sa_uint32_t mnemonicLength = 0;
+  const char* mnemonic = sa__nextLineToken(&p, pEnd, &mnemonicLength);
 
-static void sa__resetId() {
-  __gIdGeneratorHoldValue = 1;
+  return sa__tokenEquals(mnemonic, mnemonicLength, "Function") || sa__tokenEquals(mnemonic, mnemonicLength, "FunctionEnd") ||
+    sa__tokenEquals(mnemonic, mnemonicLength, "TypeInt") || sa__tokenEquals(mnemonic, mnemonicLength, "TypeFloat");
 }
 
-static sa_uint32_t sa__getOperandSectionType(sa_uint16_t op) {
-  switch(op) {
-  case saOp_Capability:
-    return saSectionType_Capability;
-
-  case saOp_Extension:
-    return saSectionType_Extensions;
-
-  case saOp_ExtInstImport:
-    return saSectionType_Imports;
-
-  case saOp_MemoryModel:
-    return saSectionType_MemoryModel;
-
-  case saOp_EntryPoint:
-    return saSectionType_EntryPoints;
-
-  case saOp_ExecutionMode:
-  case saOp_ExecutionModeId:
-    return saSectionType_ExecutionModes;
-
-  case saOp_String:
-  case saOp_Source:
-  case saOp_SourceExtension:
-  case saOp_SourceContinued:
-  case saOp_Name:
-  case saOp_MemberName:
-  case saOp_ModuleProcessed:
-    return saSectionType_Debug;
-
-  case saOp_Decorate:
-  case saOp_MemberDecorate:
-  case saOp_DecorationGroup:
-  case saOp_GroupDecorate:
-  case saOp_GroupMemberDecorate:
-  case saOp_DecorateId:
-    return saSectionType_Annotations;
-
-  case saOp_TypeArray:
-  case saOp_TypeBool:
-  case saOp_TypeDeviceEvent:
-  case saOp_TypeEvent:
-  case saOp_TypeFloat:
-  case saOp_TypeForwardPointer:
-  case saOp_TypeFunction:
-  case saOp_TypeImage:
-  case saOp_TypeInt:
-  case saOp_TypeMatrix:
-  case saOp_TypeNamedBarrier:
-  case saOp_TypeOpaque:
-  case saOp_TypePipe:
-  case saOp_TypePipeStorage:
-  case saOp_TypePointer:
-  case saOp_TypeQueue:
-  case saOp_TypeReserveId:
-  case saOp_TypeRuntimeArray:
-  case saOp_TypeSampledImage:
-  case saOp_TypeSampler:
-  case saOp_TypeStruct:
-  case saOp_TypeVector:
-  case saOp_TypeVoid:
-  case saOp_Variable:
-  case saOp_Undef:
-  case saOp_Line:
-  case saOp_Constant:
-  case saOp_ConstantFalse:
-  case saOp_ConstantTrue:
-  case saOp_ConstantNull:
-  case saOp_ConstantSampler:
-  case saOp_ConstantPipeStorage:
-  case saOp_ConstantComposite:
-    return saSectionType_Types;
-  }
-
-  return saSectionType_Functions;
-}
-
-static sa_uint32_t sa__getOrCreateSpirvId(sa__spirvIdTable_t* pIds, const char* name) {
-  for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
-    if(sa__compareString(name, pIds->pIds[i].textId) == 0)
-      return pIds->pIds[i].binaryId;
+/**
+ * @brief Assembles one line into assembly the assembler points to and records what it became
+ * 
+ * @param pSession 
+ * @param pLine line start
+ * @param length length of line with its new line
+ * @param lineNumber 
+ * @param pOut 
+ */
+static void sa__assembleSessionLine(sa_session_t* pSession, const char* pLine, sa_uint32_t length, sa_uint32_t lineNumber, sa__sessionLine_t* pOut) {
+  sa_assembler_t* pAssembler = &pSession->assembler;
+  sa__assemblySection_t* pSections = pAssembler->pAssembly->section;
+  const sa_uint32_t errorCount = pAssembler->pCtx->diagnostics.errorCount;
+  sa_uint32_t wordCounts[saSectionType_COUNT];
+  sa_uint32_t instCounts[saSectionType_COUNT];
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    wordCounts[sect] = pSections[sect].wordCount;
+    instCounts[sect] = pSections[sect].instCount;
   }
 
-  pIds->idCount++;
-  pIds->pIds = (sa__spirvId_t*)sa_realloc(pIds->pIds, sizeof(sa__spirvId_t) * pIds->idCount);
-  sa__setMemory(&pIds->pIds[pIds->idCount - 1], 0, sizeof(pIds->pIds[pIds->idCount - 1]));
-  pIds->pIds[pIds->idCount - 1].binaryId = sa__genId();
-  sa__setMemory(pIds->pIds[pIds->idCount - 1].textId, 0, sizeof(pIds->pIds[pIds->idCount - 1].textId));
-  sa__copyMemory(name, pIds->pIds[pIds->idCount - 1].textId, sa__lengthString(name));
+  pOut->section = SA_SESSION_NO_SECTION;
+  pOut->wordOffset = 0;
+  pOut->wordCount = 0;
+  pOut->insideFn = pAssembler->insideFn;
+  pOut->structural = sa__isStructuralLine(pLine, pLine + length);
+  pOut->firstId = pAssembler->ids.pUseOrder ? pAssembler->ids.pUseOrder->next : pAssembler->ids.idCount + 1;
 
-  return pIds->pIds[pIds->idCount - 1].binaryId;
-}
+  pAssembler->line = lineNumber;
+  sa__assembleLines(pAssembler, pLine, length);
 
-static void sa__createSpirvNameId(sa__spirvIdTable_t* pIds, const char* name, sa_uint32_t id) {
-  pIds->idCount++;
-  pIds->pIds = (sa__spirvId_t*)sa_realloc(pIds->pIds, sizeof(sa__spirvId_t) * pIds->idCount);
-  sa__setMemory(&pIds->pIds[pIds->idCount - 1], 0, sizeof(pIds->pIds[pIds->idCount - 1]));
-  pIds->pIds[pIds->idCount - 1].binaryId = id;
-  sa__setMemory(pIds->pIds[pIds->idCount - 1].textId, 0, sizeof(pIds->pIds[pIds->idCount - 1].textId));
-  sa__copyMemory(name, pIds->pIds[pIds->idCount - 1].textId, sa__lengthString(name));
-}
+  pOut->failed = pAssembler->pCtx->diagnostics.errorCount != errorCount;
 
-static sa_bool sa__spirvIdExist(sa__spirvIdTable_t* pIds, sa_uint32_t id) {
-   for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
-    if(pIds->pIds[i].binaryId == id)
-      return SA_TRUE;
-  }
+  // Only one instruction is recorded, line that became more (EntryPoint with its Capability) is kept up to date by assembling whole text
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    if(pSections[sect].wordCount == wordCounts[sect])
+      continue;
 
-  return SA_FALSE;
-}
+    if(pOut->section != SA_SESSION_NO_SECTION || pSections[sect].instCount - instCounts[sect] > 1) {
+      pOut->structural = SA_TRUE;
 
-static sa_bool sa__spirvIdNameExist(sa__spirvIdTable_t* pIds, const char* name) {
-   for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
-    if(sa__compareString(pIds->pIds[i].textId, name) == 0)
-      return SA_TRUE;
+      continue;
+    }
+
+    pOut->section = (sa_uint8_t)sect;
+    pOut->wordOffset = wordCounts[sect];
+    pOut->wordCount = pSections[sect].wordCount - wordCounts[sect];
   }
+}
+
+/**
+ * @brief Moves gap of session text so it starts at given offset, only text between old and new place of the gap moves
+ * 
+ * @param pSession 
+ * @param offset 
+ */
+static void sa__moveSessionTextGap(sa_session_t* pSession, sa_uint32_t offset) {
+  char* pText = pSession->pText;
+  const sa_uint32_t gap = pSession->textGap;
+  const sa_uint32_t size = pSession->textGapSize;
+
+  if(offset < gap)
+    sa__moveMemory(&pText[offset], &pText[offset + size], gap - offset);
+  else
+    sa__moveMemory(&pText[gap + size], &pText[gap], offset - gap);
 
-  return SA_FALSE;
+  pSession->textGap = offset;
 }
 
-static void sa__createJustId(sa__spirvIdTable_t* pIds, sa_uint32_t id) {
-  if(sa__spirvIdExist(pIds, id))
+/**
+ * @brief Makes gap of session text at least given size, text after the gap goes to the end of grown memory
+ * 
+ * @param pSession 
+ * @param size 
+ */
+static void sa__reserveSessionTextGap(sa_session_t* pSession, sa_uint32_t size) {
+  if(pSession->textGapSize >= size)
     return;
 
-  pIds->idCount++;
-  pIds->pIds = (sa__spirvId_t*)sa_realloc(pIds->pIds, sizeof(sa__spirvId_t) * pIds->idCount);
-  sa__setMemory(&pIds->pIds[pIds->idCount - 1], 0, sizeof(pIds->pIds[pIds->idCount - 1]));
-  pIds->pIds[pIds->idCount - 1].binaryId = sa__genId();
+  const sa_uint32_t oldCapacity = pSession->textCapacity;
+  const sa_uint32_t tail = pSession->length - pSession->textGap;
+
+  pSession->pText = (char*)sa__growArray(pSession->pText, sizeof(char), &pSession->textCapacity, pSession->length + size, SA_NULL);
+  sa__moveMemory(&pSession->pText[oldCapacity - tail], &pSession->pText[pSession->textCapacity - tail], tail);
+
+  pSession->textGapSize = pSession->textCapacity - pSession->length;
 }
 
-static const char* sa__getSpirvName(sa__spirvIdTable_t* pIds, sa_uint32_t id) {
-  for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
-    if(pIds->pIds[i].binaryId == id)
-      return pIds->pIds[i].textId;
-  }
+/**
+ * @brief Switches offsets of line record between counted from the start and counted back from the end of text, section and ids.
+ * Doing it twice gives back the same record
+ * 
+ * @param pSession 
+ * @param pLine 
+ */
+static void sa__flipSessionLine(const sa_session_t* pSession, sa__sessionLine_t* pLine) {
+  pLine->textOffset = pSession->length - pLine->textOffset;
+  pLine->firstId = pSession->assembler.ids.idCount + 1 - pLine->firstId;
+
+  // Names of ids go after instructions from lines, so for lines Name section ends where names start
+  if(pLine->section == sa__getOperandSectionType(saOp_Name))
+    pLine->wordOffset = pSession->idNamesOffset - pLine->wordOffset;
+  else if(pLine->section != SA_SESSION_NO_SECTION)
+    pLine->wordOffset = pSession->assembly.section[pLine->section].wordCount - pLine->wordOffset;
+}
 
-  return SA_NULL;
+/**
+ * @brief Gives line record with offsets counted from the start, wherever it is compared to the gap
+ * 
+ * @param pSession 
+ * @param index 
+ * @return sa__sessionLine_t 
+ */
+static sa__sessionLine_t sa__getSessionLine(const sa_session_t* pSession, sa_uint32_t index) {
+  if(index < pSession->lineGap)
+    return pSession->pLines[index];
+
+  sa__sessionLine_t line = pSession->pLines[index + pSession->lineGapSize];
+
+  sa__flipSessionLine(pSession, &line);
+
+  return line;
 }
 
-static sa_uint32_t sa__getSpirvId(sa__spirvIdTable_t* pIds, const char* name) {
-  for(sa_uint32_t i = 0; i < pIds->idCount; i++) {
-    if(sa__compareString(pIds->pIds[i].textId, name) == 0)
-      return pIds->pIds[i].binaryId;
+/**
+ * @brief Moves gap of line records so it starts at given line, only records between old and new place of the gap move
+ * 
+ * @param pSession 
+ * @param index 
+ */
+static void sa__moveSessionLineGap(sa_session_t* pSession, sa_uint32_t index) {
+  while(pSession->lineGap > index) {
+    pSession->lineGap--;
+
+    sa__sessionLine_t* pLine = &pSession->pLines[pSession->lineGap + pSession->lineGapSize];
+
+    *pLine = pSession->pLines[pSession->lineGap];
+    sa__flipSessionLine(pSession, pLine);
   }
 
-  return SA_UINT32_MAX;
+  while(pSession->lineGap < index) {
+    sa__sessionLine_t* pLine = &pSession->pLines[pSession->lineGap];
+
+    *pLine = pSession->pLines[pSession->lineGap + pSession->lineGapSize];
+    sa__flipSessionLine(pSession, pLine);
+
+    pSession->lineGap++;
+  }
 }
 
-static void sa__freeSpirvIdTable(sa__spirvIdTable_t* pIds) {
-  sa_free(pIds->pIds);
-  pIds->pIds = SA_NULL;
-  pIds->idCount = 0;
+/**
+ * @brief Makes gap of line records at least given size, records after the gap go to the end of grown memory
+ * 
+ * @param pSession 
+ * @param count 
+ */
+static void sa__reserveSessionLineGap(sa_session_t* pSession, sa_uint32_t count) {
+  if(pSession->lineGapSize >= count)
+    return;
+
+  const sa_uint32_t oldCapacity = pSession->lineCapacity;
+  const sa_uint32_t tail = pSession->lineCount - pSession->lineGap;
+
+  pSession->pLines = (sa__sessionLine_t*)sa__growArray(pSession->pLines, sizeof(sa__sessionLine_t), &pSession->lineCapacity, pSession->lineCount + count, SA_NULL);
+  // Records are whole words, moving them by words is faster than by bytes
+  sa__moveWords((const sa_uint32_t*)&pSession->pLines[oldCapacity - tail], (sa_uint32_t*)&pSession->pLines[pSession->lineCapacity - tail], tail * (sizeof(sa__sessionLine_t) / sizeof(sa_uint32_t)));
+
+  pSession->lineGapSize = pSession->lineCapacity - pSession->lineCount;
 }
 
 /**
- * @brief Checks if such a mnemonic is valid SPIRV operand
+ * @brief Assembles whole session text from nothing, id table memory is reused
  * 
- * @param mnemonic 
- * @return sa_uint32_t index to that operand table or UINT32_MAX if non existant
+ * @param pSession 
  */
-static sa_uint32_t sa__findLowLevelMnemonic(const char* mnemonic) {
-  for(sa_uint32_t i = 0; i < sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES) / sizeof(SA_ASSEMBLER_LOW_LEVEL_OPCODES[0]); i++) {
-    if(sa__compareString(SA_ASSEMBLER_LOW_LEVEL_OPCODES[i].opcodeMnemonic, mnemonic) == 0)
-      return i;
+static void sa__rebuildSession(sa_session_t* pSession) {
+  sa_assembler_t* pAssembler = &pSession->assembler;
+  sa__spirvIdTable_t ids = pAssembler->ids;
+
+  sa__moveSessionTextGap(pSession, pSession->length);
+
+  const char* const pEnd = pSession->pText + pSession->length;
+  const char* p = pSession->pText;
+
+  sa_freeAssembly(&pSession->assembly);
+  sa__resetSpirvIdTable(&ids);
+
+  sa_assembleBegin(pAssembler->pCtx, pAssembler, &pSession->assembly);
+  pAssembler->ids = ids;
+
+  // Last line is the one after last new line, it can be empty
+  pSession->lineCount = 1 + sa__countClass(p, pEnd, SA_CHAR_NEWLINE);
+  pSession->pLines = (sa__sessionLine_t*)sa__growArray(pSession->pLines, sizeof(sa__sessionLine_t), &pSession->lineCapacity, pSession->lineCount, SA_NULL);
+  pSession->lineGap = pSession->lineCount;
+  pSession->lineGapSize = pSession->lineCapacity - pSession->lineCount;
+  pSession->failedLines = 0;
+  sa__setMemory(pSession->sectionLines, 0, sizeof(pSession->sectionLines));
+
+  for(sa_uint32_t i = 0; i < pSession->lineCount; i++) {
+    const char* next = sa__nextLine(p, pEnd);
+    sa__sessionLine_t* pLine = &pSession->pLines[i];
+
+    sa__assembleSessionLine(pSession, p, next - p, i + 1, pLine);
+    pLine->textOffset = p - pSession->pText;
+
+    if(pLine->section != SA_SESSION_NO_SECTION)
+      pSession->sectionLines[pLine->section]++;
+
+    pSession->failedLines += pLine->failed;
+    p = next;
   }
 
-  return SA_UINT32_MAX;
+  pSession->idNamesOffset = pSession->assembly.section[sa__getOperandSectionType(saOp_Name)].wordCount;
+
+  sa__finishAssembly(pAssembler);
 }
 
 /**
- * @brief 
+ * @brief Finds line that holds given text offset
  * 
- * @param pSection 
- * @param wordSize Includes opcode 
- * @param op opcode
- * @param words all the parameters
+ * @param pSession 
+ * @param offset 
+ * @return sa_uint32_t line index
  */
-static void sa__addInstruction(sa__assemblySection_t* pSection, sa_uint16_t wordSize, sa_uint16_t op, sa_uint32_t* words) {
-  if(!pSection) {
-    sa__errMsg("Cannot find section");
-    
-    return;
+static sa_uint32_t sa__findSessionLine(const sa_session_t* pSession, sa_uint32_t offset) {
+  sa_uint32_t low = 0;
+  sa_uint32_t high = pSession->lineCount - 1;
+
+  while(low < high) {
+    const sa_uint32_t middle = low + (high - low + 1) / 2;
+
+    if(sa__getSessionLine(pSession, middle).textOffset <= offset)
+      low = middle;
+    else
+      high = middle - 1;
   }
 
-  pSection->instCount++;
+  return low;
+}
 
-  if(pSection->pInst)
-    pSection->pInst = (sa__assemblyInstruction_t*)sa_realloc(pSection->pInst, sizeof(sa__assemblyInstruction_t) * pSection->instCount);
-  else
-    pSection->pInst = (sa__assemblyInstruction_t*)sa_calloc(pSection->instCount, sizeof(sa__assemblyInstruction_t));
+/**
+ * @brief Finds where instructions of lines first..last would go in section when none of those lines has instruction there
+ * 
+ * @param pSession 
+ * @param first 
+ * @param last 
+ * @param section 
+ * @return sa_uint32_t word offset inside section, SA_UINT32_MAX when no line has instruction there even though count of them says so
+ */
+static sa_uint32_t sa__findSessionInsertion(const sa_session_t* pSession, sa_uint32_t first, sa_uint32_t last, sa_uint32_t section) {
+  // Instructions of lines go before names of ids, and there is nothing to look for when no other line has instruction in section
+  if(pSession->sectionLines[section] == 0)
+    return section == sa__getOperandSectionType(saOp_Name) ? pSession->idNamesOffset : pSession->assembly.section[section].wordCount;
 
-  // -1 for last instruction
-  sa__setMemory(&pSection->pInst[pSection->instCount - 1], 0, sizeof(pSection->pInst[pSection->instCount - 1]));
+  // Closest line with instruction in section, looking both ways at once
+  sa_uint32_t before = first;
+  sa_uint32_t after = last + 1;
 
-  pSection->pInst[pSection->instCount - 1].opCode = op;
-  pSection->pInst[pSection->instCount - 1].wordSize = wordSize;
-  pSection->pInst[pSection->instCount - 1].words = (sa_uint32_t*)sa_calloc((wordSize - 1), sizeof(sa_uint32_t));
+  while(before > 0 || after < pSession->lineCount) {
+    if(before > 0) {
+      const sa__sessionLine_t line = sa__getSessionLine(pSession, --before);
 
-  //sa__setMemory(pSection->pInst[pSection->instCount - 1].words, 0, sizeof(sa_uint32_t) * (wordSize - 1));
+      if(line.section == section)
+        return line.wordOffset + line.wordCount;
+    }
 
-  if(!pSection->pInst[pSection->instCount - 1].words) {
-    sa__errMsg("Cannot allocate memory for pSection->pInst[pSection->instCount - 1].words");
+    if(after < pSession->lineCount) {
+      const sa__sessionLine_t line = sa__getSessionLine(pSession, after++);
 
-    return;
+      if(line.section == section)
+        return line.wordOffset;
+    }
   }
 
-  sa__copyMemory(words, pSection->pInst[pSection->instCount - 1].words, (wordSize - 1) * sizeof(sa_uint32_t));
+  return SA_UINT32_MAX;
 }
 
-static void sa_freeAssembly(sa_assembly_t* pAsm) {
-  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
-    for(sa_uint32_t i = 0; i < pAsm->section[sect].instCount; i++) {
-      sa_free(pAsm->section[sect].pInst[i].words);
-      pAsm->section[sect].pInst[i].words = SA_NULL;
-      pAsm->section[sect].pInst[i].opCode = 0;
-      pAsm->section[sect].pInst[i].wordSize = 0;
-    }
+/**
+ * @brief Replaces words of section with instructions from another section, instruction offsets are moved along
+ * 
+ * @param pAssembly 
+ * @param section 
+ * @param offset first replaced word
+ * @param oldWords amount of replaced words
+ * @param oldInsts amount of replaced instructions
+ * @param pNew instructions that go in their place
+ */
+static void sa__patchSection(sa_assembly_t* pAssembly, sa_uint32_t section, sa_uint32_t offset, sa_uint32_t oldWords, sa_uint32_t oldInsts, const sa__assemblySection_t* pNew) {
+  sa__assemblySection_t* pSection = &pAssembly->section[section];
+  const sa_uint32_t wordCount = pSection->wordCount - oldWords + pNew->wordCount;
+  const sa_uint32_t instCount = pSection->instCount - oldInsts + pNew->instCount;
+  sa_uint32_t firstInst = 0;
+  sa_uint32_t high = pSection->instCount;
+
+  // Instruction offsets are sorted, first replaced one is the first not before offset
+  while(firstInst < high) {
+    const sa_uint32_t middle = firstInst + (high - firstInst) / 2;
+
+    if(pSection->pInstOffsets[middle] < offset)
+      firstInst = middle + 1;
+    else
+      high = middle;
+  }
+
+  sa_reserveSection(pAssembly, section, instCount, wordCount);
 
-    sa_free(pAsm->section[sect].pInst);
-    pAsm->section[sect].pInst = SA_NULL;
-    pAsm->section[sect].instCount = 0;
+  sa__moveWords(&pSection->pWords[offset + oldWords], &pSection->pWords[offset + pNew->wordCount], pSection->wordCount - offset - oldWords);
+  sa__copyWords(pNew->pWords, &pSection->pWords[offset], pNew->wordCount);
+
+  sa__moveWords(&pSection->pInstOffsets[firstInst + oldInsts], &pSection->pInstOffsets[firstInst + pNew->instCount], pSection->instCount - firstInst - oldInsts);
+
+  for(sa_uint32_t i = 0; i < pNew->instCount; i++)
+    pSection->pInstOffsets[firstInst + i] = pNew->pInstOffsets[i] + offset;
+
+  if(pNew->wordCount != oldWords) {
+    for(sa_uint32_t i = firstInst + pNew->instCount; i < instCount; i++)
+      pSection->pInstOffsets[i] += pNew->wordCount - oldWords;
   }
 
-  pAsm->header.bounds = 0;
-  pAsm->header.generator = 0;
-  pAsm->header.magic = 0;
-  pAsm->header.schema = 0;
-  pAsm->header.version = 0;
+  pSection->wordCount = wordCount;
+  pSection->instCount = instCount;
 }
 
-static void sa_freeSPIRV(sa_uint8_t* spirvBin) {
-  sa_free(spirvBin);
+/**
+ * @brief Starts session, text is copied and assembled
+ * 
+ * @param pCtx context, SA_NULL for default one. It is used by every edit of the session
+ * @param pSession 
+ * @param text does not need to be null terminated
+ * @param length length of text in bytes
+ */
+static void sa_sessionBegin(sa_context_t* pCtx, sa_session_t* pSession, const char* text, sa_uint32_t length) {
+  sa__setMemory(pSession, 0, sizeof(*pSession));
+
+  pSession->assembler.pCtx = sa__resolveContext(pCtx);
+  pSession->length = length;
+  pSession->pText = (char*)sa__growArray(SA_NULL, sizeof(char), &pSession->textCapacity, length + 1, SA_NULL);
+  sa__copyMemory(text, pSession->pText, length);
+
+  pSession->textGap = length;
+  pSession->textGapSize = pSession->textCapacity - length;
+
+  sa__rebuildSession(pSession);
 }
 
 /**
- * @brief Gets enum for instruction. Instruction must support that enum
+ * @brief Replaces range of session text and updates pSession->assembly, result is always the same as assembling whole text. Only touched lines are assembled again and spliced into sections. Whole text is assembled again when edit touches Function, FunctionEnd, TypeInt or TypeFloat lines or lines that become more than one instruction (EntryPoint with its Capability), when text has errors, so error messages stay complete, or when edited lines change which ids are used first (ids are numbered by first use, so that would renumber ids of lines after them, or leave names of ids nothing uses).
+ * Text and line records keep a gap after the last edit, so they only move between this edit and the one before. Sections stay whole arrays
+ * that sa_bakeSPIRV and users read as they are, so instruction of other size still moves the rest of its section
  * 
- * @param instructionIndex index to the instruction/opcode table
- * @param enumName enum mnemonic
- * @return sa_uint32_t enum or SA_UINT32_t on error
+ * @param pSession 
+ * @param start first replaced byte
+ * @param end byte past last replaced one, equal to start for insertion
+ * @param text new text of the range, does not need to be null terminated
+ * @param length length of new text
+ * @return sa_bool SA_TRUE if assembly was patched in place, SA_FALSE if whole text was assembled again or range is wrong
  */
-static sa_uint32_t sa__getLowLevelInstructionEnum(sa_uint32_t instructionIndex, const char* enumName) {
-  sa_uint32_t enumsCount = 0;
+static sa_bool sa_sessionEdit(sa_session_t* pSession, sa_uint32_t start, sa_uint32_t end, const char* text, sa_uint32_t length) {
+  sa_assembler_t* pAssembler = &pSession->assembler;
+
+  if(start > end || end > pSession->length || (!text && length > 0)) {
+    sa__errMsg(pAssembler->pCtx, saDiagnostic_InvalidArgument, "Edit range %d..%d is outside of text (%d bytes)", start, end, pSession->length);
+
+    return SA_FALSE;
+  }
+
+  const sa_uint32_t first = sa__findSessionLine(pSession, start);
+  const sa_uint32_t last = sa__findSessionLine(pSession, end);
+
+  // Lines first..last get offsets counted from the start, lines after them keep theirs counted from the end while text, sections and ids change,
+  // so only lines between this edit and the one before are touched
+  sa__moveSessionLineGap(pSession, last + 1);
+
+  const sa_uint32_t firstNewId = pAssembler->ids.idCount;
+  const sa_uint32_t rangeStart = pSession->pLines[first].textOffset;
+  sa_uint32_t rangeEnd = pSession->length;
+  // Ids first used by old lines of the range, lines after it start using ids from idsEnd
+  sa_uint32_t idsEnd = firstNewId + 1;
+  sa_bool patch = pSession->failedLines == 0;
+
+  if(last + 1 < pSession->lineCount) {
+    const sa__sessionLine_t next = sa__getSessionLine(pSession, last + 1);
+
+    rangeEnd = next.textOffset;
+    idsEnd = next.firstId;
+  }
+
+  for(sa_uint32_t i = first; i <= last && patch; i++)
+    patch = !pSession->pLines[i].structural;
+
+  // Gap goes to the end of the range and takes it in, new text is written at its start
+  sa__reserveSessionTextGap(pSession, length);
+  sa__moveSessionTextGap(pSession, end);
+  sa__copyMemory(text, &pSession->pText[start], length);
+
+  const sa_uint32_t textDelta = length - (end - start);
+  const sa_uint32_t newRangeEnd = rangeEnd + textDelta;
+
+  pSession->textGap = start + length;
+  pSession->textGapSize -= textDelta;
+  pSession->length += textDelta;
+
+  if(!patch) {
+    sa__rebuildSession(pSession);
+
+    return SA_FALSE;
+  }
+
+  // Rest of the last line goes before the gap, so lines first..last are read in place
+  sa__moveSessionTextGap(pSession, newRangeEnd);
+
+  // Range ends at line start, unless it goes up to the end of text where there is one more line
+  const char* const pEnd = pSession->pText + newRangeEnd;
+  const char* p = pSession->pText + rangeStart;
+  const sa_uint32_t editLineCount = sa__countClass(p, pEnd, SA_CHAR_NEWLINE) + (newRangeEnd == pSession->length);
+  sa__idUseOrder_t useOrder = { pSession->pLines[first].firstId, SA_FALSE };
+
+  pSession->pEditLines = (sa__sessionLine_t*)sa__growArray(pSession->pEditLines, sizeof(sa__sessionLine_t), &pSession->editLineCapacity, editLineCount, SA_NULL);
+
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    pSession->scratch.section[sect].wordCount = 0;
+    pSession->scratch.section[sect].instCount = 0;
+  }
+
+  pAssembler->pAssembly = &pSession->scratch;
+  pAssembler->insideFn = pSession->pLines[first].insideFn;
+  pAssembler->ids.pUseOrder = &useOrder;
+
+  for(sa_uint32_t i = 0; i < editLineCount && patch; i++) {
+    const char* next = sa__nextLine(p, pEnd);
+    sa__sessionLine_t* pLine = &pSession->pEditLines[i];
+
+    sa__assembleSessionLine(pSession, p, next - p, first + i + 1, pLine);
+    pLine->textOffset = p - pSession->pText;
+
+    patch = !pLine->structural && !pLine->failed;
+    p = next;
+  }
+
+  pAssembler->pAssembly = &pSession->assembly;
+  pAssembler->ids.pUseOrder = SA_NULL;
+
+  // New lines have to use first every id old ones did, in the same order. New ids are only fine when lines after the range use none first
+  if(useOrder.broken || useOrder.next < idsEnd || (useOrder.next > idsEnd && idsEnd != firstNewId + 1))
+    patch = SA_FALSE;
 
-  for(; enumsCount < saAsmEnum_COUNT; enumsCount++) {
-    if(SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].possibleEnumerant[enumsCount] == SA_UINT32_MAX)
-      break;
+  // Errors need every line assembled again to be reported in order
+  if(!patch) {
+    sa__rebuildSession(pSession);
+
+    return SA_FALSE;
   }
 
-  for(sa_uint32_t eId = 0; eId < enumsCount; eId++) {
-    sa_uint32_t tableId = SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].possibleEnumerant[eId];
+  sa_uint32_t wordDelta[saSectionType_COUNT];
+  sa_uint32_t wordBase[saSectionType_COUNT];
+  sa_uint32_t oldWords[saSectionType_COUNT];
+  sa_uint32_t oldInsts[saSectionType_COUNT];
 
-    for(sa_uint32_t i = 0; i < SA_MAX_ENUMERANT_ENTRIES; i++) {
-      if(!SA_ASSEMBLER_LOW_LEVEL_ENUMS[tableId][i].enumerantMnemonic)
-        break;
+  // Every place is found before anything is patched, so whole text can still be assembled when one is missing
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    wordBase[sect] = SA_UINT32_MAX;
+    oldWords[sect] = 0;
+    oldInsts[sect] = 0;
+
+    // Instructions of lines in one section follow text order, so the ones of the range are next to each other
+    for(sa_uint32_t i = first; i <= last; i++) {
+      if(pSession->pLines[i].section != sect)
+        continue;
+
+      if(wordBase[sect] == SA_UINT32_MAX)
+        wordBase[sect] = pSession->pLines[i].wordOffset;
+
+      oldWords[sect] += pSession->pLines[i].wordCount;
+      oldInsts[sect]++;
+    }
+
+    wordDelta[sect] = pSession->scratch.section[sect].wordCount - oldWords[sect];
+
+    if(wordBase[sect] == SA_UINT32_MAX && pSession->scratch.section[sect].instCount > 0) {
+      wordBase[sect] = sa__findSessionInsertion(pSession, first, last, sect);
+
+      if(wordBase[sect] == SA_UINT32_MAX) {
+        sa__rebuildSession(pSession);
 
-      if(sa__compareString(SA_ASSEMBLER_LOW_LEVEL_ENUMS[tableId][i].enumerantMnemonic, enumName) == 0)
-        return SA_ASSEMBLER_LOW_LEVEL_ENUMS[tableId][i].enumerant;
+        return SA_FALSE;
+      }
     }
   }
 
-  return SA_UINT32_MAX;
-}
+  for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
+    const sa__assemblySection_t* pNew = &pSession->scratch.section[sect];
 
-static sa_uint32_t sa__parserLowLevelSkipComment(const char * const spirvAssemblyStrStart) {
-  char* p = (char*)spirvAssemblyStrStart;
+    if(oldInsts[sect] == 0 && pNew->instCount == 0)
+      continue;
 
-  // If after skipping all the white spaces p == NL, return it as a just an empty line
-  if(*p == '\n' /*|| *p == '\r'*/) {
-    //if(*p == '\r')
-    //  p++;
+    sa__patchSection(&pSession->assembly, sect, wordBase[sect], oldWords[sect], oldInsts[sect], pNew);
 
-    p++;
+    pSession->sectionLines[sect] += pNew->instCount - oldInsts[sect];
 
-    return p - spirvAssemblyStrStart; 
+    if(sect == sa__getOperandSectionType(saOp_Name))
+      pSession->idNamesOffset += wordDelta[sect];
   }
 
-  if(*p == ';') {
-    // Skip comment (full line)
-    while(*p != '\n' && *p != '\0')
-      p++;
+  // Gap takes in old lines of the range and edited ones are written in their place, lines after the gap stay as they are
+  pSession->lineGap = first;
+  pSession->lineGapSize += last - first + 1;
+  pSession->lineCount -= last - first + 1;
 
-    if(*p == 0)
-      return p - spirvAssemblyStrStart;
+  sa__reserveSessionLineGap(pSession, editLineCount);
 
-    // Skip NL char
-    p++;
+  for(sa_uint32_t i = 0; i < editLineCount; i++) {
+    sa__sessionLine_t* pLine = &pSession->pLines[first + i];
 
-    // return pointer to the next line
-    return p - spirvAssemblyStrStart;
+    *pLine = pSession->pEditLines[i];
+
+    if(pLine->section != SA_SESSION_NO_SECTION)
+      pLine->wordOffset += wordBase[pLine->section];
   }
 
-  if(*p == 0)
-    return p - spirvAssemblyStrStart;
+  pSession->lineGap += editLineCount;
+  pSession->lineGapSize -= editLineCount;
+  pSession->lineCount += editLineCount;
 
-  return SA_UINT32_MAX;
+  // Names of new ids go after names of old ones, same as ids themselves
+  if(pAssembler->ids.idCount > firstNewId) {
+    pSession->assembly.header.bounds = pAssembler->ids.idCount + 1;
+    sa__addIdNames(pAssembler, firstNewId);
+  }
+
+  return SA_TRUE;
 }
 
 /**
- * @brief Parses instruction to the spirv assembly struct
+ * @brief Gives session text, gap left by edits is moved to its end for that
  * 
- * @param spirvAssemblyStrStart string of a spirv assembly where spirvAssemblyStrStart[0] == first letter of a operand mnemonic
- * @param pAssembly pointer to the assemblt
- * @param pInsideFn set to true if operand is inside function, this is required to skip most of opcodes that would be created in wrong section, like variables 
- * @return sa_uint32_t index to the next operand or SA_UINT32_MAX on error
+ * @param pSession 
+ * @return const char* null terminated text, valid until next edit
  */
-static sa_uint32_t sa__parseLowLevelInstruction(const char * const spirvAssemblyStrStart, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa_bool* pInsideFn, sa_uint32_t line) {
-  if(!spirvAssemblyStrStart) {
-    sa__errMsg("Cannot find start point for assembly plain");
+static const char* sa_sessionText(sa_session_t* pSession) {
+  sa__reserveSessionTextGap(pSession, 1);
+  sa__moveSessionTextGap(pSession, pSession->length);
 
-    return SA_UINT32_MAX;
-  }
+  pSession->pText[pSession->length] = '\0';
 
-  if(!pAssembly) {
-    sa__errMsg("Cannot find assembly struct");
+  return pSession->pText;
+}
 
-    return SA_UINT32_MAX;
-  }
+/**
+ * @brief Frees session together with its assembly
+ * 
+ * @param pSession 
+ */
+static void sa_sessionEnd(sa_session_t* pSession) {
+  sa__freeSpirvIdTable(&pSession->assembler.ids);
+  sa_freeAssembly(&pSession->assembly);
+  sa_freeAssembly(&pSession->scratch);
+  sa_free(pSession->pText);
+  sa_free(pSession->pLines);
+  sa_free(pSession->pEditLines);
+  sa__setMemory(pSession, 0, sizeof(*pSession));
+}
 
-  if(!pIds) {
-    sa__errMsg("Cannot find spirv IDs table");
+/**
+ * @brief Checks every header word of binary
+ * 
+ * @param pCtx context to report why header is wrong, SA_NULL to only check
+ * @param pWords 
+ * @param wordCount size of binary in words
+ * @return sa_bool 
+ */
+static sa_bool sa__checkSpirvHeader(sa_context_t* pCtx, const sa_uint32_t* pWords, sa_uint32_t wordCount) {
+  if(wordCount < (sizeof(sa__assemblyHeader_t) / sizeof(sa_uint32_t))) {
+    if(pCtx)
+      sa__errMsg(pCtx, saDiagnostic_WrongHeader, "Binary has %d words, header alone needs 5", wordCount);
 
-    return SA_UINT32_MAX;
+    return SA_FALSE;
   }
 
-  char* p = (char*)spirvAssemblyStrStart;
+  const sa_uint32_t magic = SA_CONVERT(pWords[0]);
+  const sa_uint32_t version = SA_CONVERT(pWords[1]);
 
-  // Skip all white chars at the beginning as they are valid 
-  while(sa__isShortWhite(*p))
-    p++;
+  if(magic != SA_SPIRV_MAGIC_NUMBER) {
+    const sa_uint32_t swapped = (magic >> 24) | ((magic >> 8) & 0xFF00) | ((magic << 8) & 0xFF0000) | (magic << 24);
 
-  sa_uint32_t skipCommentSize = sa__parserLowLevelSkipComment(p);
+    if(pCtx && swapped == SA_SPIRV_MAGIC_NUMBER)
+      sa__errMsg(pCtx, saDiagnostic_WrongMagic, "SPIR-V binary has other byte order than this machine\n");
+    else if(pCtx)
+      sa__errMsg(pCtx, saDiagnostic_WrongMagic, "SPIR-V Magic number does not match file magic number!\n");
 
-  if(skipCommentSize != SA_UINT32_MAX)
-    return skipCommentSize;
+    return SA_FALSE;
+  }
 
-  // That should be mnemonic start
-  char* mnemonicStart = p;
+  // Version is 0 | major | minor | 0 and only major 1 exists
+  if((version & 0xFFFF00FF) != 0x00010000) {
+    if(pCtx)
+      sa__errMsg(pCtx, saDiagnostic_WrongHeader, "SPIR-V version %x is not supported", version);
 
-  // Everything in lowest level assembly is divided by spaces, 1 instruction per line
-  while(!sa__isShortWhite(*p) && *p != '\n' && *p != 0)
-    p++;
+    return SA_FALSE;
+  }
 
-  char* mnemonicEnd = p;
-  char mnemonic[256] = {0};
-  
-  sa__setMemory(mnemonic, 0, sizeof(mnemonic));
-  // Copy read mnemonic to temp mnemonic buffer
-  sa__copyMemory(mnemonicStart, mnemonic, mnemonicEnd - mnemonicStart);
+  // Every id is above 0 and below bound, so 0 means there is nothing valid that could use ids
+  if(SA_CONVERT(pWords[3]) == 0) {
+    if(pCtx)
+      sa__errMsg(pCtx, saDiagnostic_WrongHeader, "Id bound of binary is 0");
 
-  // Check if mnemonic actually exist
-  sa_uint32_t instructionIndex = sa__findLowLevelMnemonic(mnemonic);
+    return SA_FALSE;
+  }
 
-  if(instructionIndex == SA_UINT32_MAX) {
-    sa__errMsg("Mnemonic \"%s\" does not exist @ line %d", mnemonic, line);
+  if(SA_CONVERT(pWords[4]) != 0) {
+    if(pCtx)
+      sa__errMsg(pCtx, saDiagnostic_WrongHeader, "Schema of binary is %x, it has to be 0", SA_CONVERT(pWords[4]));
 
-    return SA_UINT32_MAX;
+    return SA_FALSE;
   }
 
-  sa_uint16_t operand = SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].opcode;
-  sa_uint16_t minimalWordCount = SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].wordCount;
+  return SA_TRUE;
+}
 
-  if(operand == saOp_Function)
-    *pInsideFn = SA_TRUE;
+/**
+ * @brief Starts walking binary in place, pShaderBin has to outlive the view
+ * 
+ * @param pView 
+ * @param pShaderBin SPIR-V binary, 4 byte aligned
+ * @param wordCount size of binary in words
+ * @return sa_bool SA_FALSE if binary is too small for header or header is not valid
+ */
+static sa_bool sa_spirvViewBegin(sa_spirvView_t* pView, const sa_uint8_t* pShaderBin, sa_uint32_t wordCount) {
+  sa__setMemory(pView, 0, sizeof(*pView));
 
-  if(operand == saOp_FunctionEnd)
-    *pInsideFn = SA_FALSE;
+  const sa_uint32_t* pWords = (const sa_uint32_t*)pShaderBin;
 
-  // -1 to cut off mnemonic from opcode
-  char** allArgs = (char**)sa_calloc(minimalWordCount - 1, sizeof(char*));
-  sa_uint32_t argsCounter = 0;
+  if(!pShaderBin || !sa__checkSpirvHeader(SA_NULL, pWords, wordCount))
+    return SA_FALSE;
 
-  if(!allArgs) {
-    sa__errMsg("Cannot allocate memory for allArgs");
+  pView->header.magic = SA_CONVERT(pWords[0]);
+  pView->header.version = SA_CONVERT(pWords[1]);
+  pView->header.generator = SA_CONVERT(pWords[2]);
+  pView->header.bounds = SA_CONVERT(pWords[3]);
+  pView->header.schema = SA_CONVERT(pWords[4]);
 
-    return SA_UINT32_MAX;
-  }
-  
-  while(*p != '\n' && *p != 0) {
-    while(sa__isShortWhite(*p))
-      p++;
+  pView->pWords = pWords;
+  pView->wordCount = wordCount;
+  // Skip header
+  pView->offset = sizeof(sa__assemblyHeader_t) / sizeof(sa_uint32_t);
 
-    char* argStart = p;
+  return SA_TRUE;
+}
 
-    while(!sa__isShortWhite(*p) && *p != '\n' && *p != 0)
-      p++;
+/**
+ * @brief Gets next instruction, words of returned view point straight into binary
+ * 
+ * @param pView 
+ * @param pInstOut opcode, word count (with opcode word) and operands of instruction
+ * @return sa_bool SA_FALSE at the end of binary or when instruction is malformed
+ */
+static sa_bool sa_spirvViewNext(sa_spirvView_t* pView, sa__assemblyInstruction_t* pInstOut) {
+  if(pView->malformed || pView->offset >= pView->wordCount)
+    return SA_FALSE;
 
-    char* argEnd = p;
+  const sa_uint32_t word = SA_CONVERT(pView->pWords[pView->offset]);
+  const sa_uint32_t wordSize = word >> 16;
 
-    argsCounter++;
+  // Zero would never advance and too big one would read past binary. Zero wraps around to the highest value, so one compare catches both
+  if(wordSize - 1 >= pView->wordCount - pView->offset) {
+    pView->malformed = SA_TRUE;
 
-    if(argsCounter > (minimalWordCount - 1))
-      allArgs = (char**)sa_realloc(allArgs, argsCounter * sizeof(char*));
+    return SA_FALSE;
+  }
 
-    allArgs[argsCounter - 1] = (char*)sa_calloc(argEnd - argStart + 1, sizeof(char));
+  pInstOut->opCode = word & 0x0000FFFF;
+  pInstOut->wordSize = (sa_uint16_t)wordSize;
+  pInstOut->words = (sa_uint32_t*)&pView->pWords[pView->offset + 1];
 
-    sa__copyMemory(argStart, allArgs[argsCounter - 1], argEnd - argStart);
+  pView->offset += wordSize;
 
-    if(!allArgs[argsCounter - 1]) {
-      sa__errMsg("Cannot allocate memory for allArgs[argsCounter - 1]");
+  return SA_TRUE;
+}
 
-      return SA_UINT32_MAX;
-    }
-  }
+/**
+ * @brief disassemble SPIR-V shader. Binary does not need to be trusted, header and size of every instruction are checked and disassembly stops at the first malformed instruction
+ * 
+ * @param pAsm assembly to fill, it is overwritten without being freed (free one filled before with sa_freeAssembly). Left unchanged when binary is rejected
+ * @param shaderBin 4 byte aligned
+ * @param shaderSize size must be as a amount of elements inside SPIR-V in 32bit format (so read file length / sizeof(int))
+ */
+static void sa_disassembleSPIRV(sa_context_t* pCtx, sa_assembly_t* pAsm, sa_uint8_t* shaderBin, sa_uint32_t shaderSize) {
+  pCtx = sa__resolveContext(pCtx);
 
-  sa_uint32_t* words = (sa_uint32_t*)sa_calloc(minimalWordCount - 1, sizeof(sa_uint32_t));
-  sa_uint32_t wordsSize = 0;
+  sa__clearDiagnostics(&pCtx->diagnostics);
 
-  if(!words) {
-    sa__errMsg("Cannot allocate memory for words");
+  if(!pAsm) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "No assembly");
 
-    return SA_UINT32_MAX;
+    return;
   }
 
-  for(sa_uint32_t i = 0; i < argsCounter; i++) {
-    char* arg = allArgs[i];
-    
-    // Check if function is not extendable yet exceeds word count
-    if(!SA_ASSEMBLER_LOW_LEVEL_OPCODES[instructionIndex].plusVariable && wordsSize > (minimalWordCount - 1)) {
-      sa__errMsg("%s is not extendable type, yet assembler found more than %d arguments @ line %d", mnemonic, minimalWordCount, line);
+  // Words are read in place, unaligned ones cannot be read portably
+  if(!shaderBin || (size_t)shaderBin % sizeof(sa_uint32_t) != 0) {
+    sa__errMsg(pCtx, saDiagnostic_InvalidArgument, "Binary is missing or not aligned to 4 bytes");
 
-      return SA_UINT32_MAX;
-    }
+    return;
+  }
 
-    wordsSize++;
+  sa_spirvView_t view;
 
-    if(wordsSize > (minimalWordCount - 1)) {
-      words = (sa_uint32_t*)sa_realloc(words, wordsSize * sizeof(sa_uint32_t));
-      words[wordsSize - 1] = 0;
-    }
+  // Rejected binary leaves assembly as it was
+  if(!sa__checkSpirvHeader(pCtx, (const sa_uint32_t*)shaderBin, shaderSize) || !sa_spirvViewBegin(&view, shaderBin, shaderSize))
+    return;
 
-    if(!words) {
-      sa__errMsg("Cannot reallocate memory for words");
+  sa__setMemory(pAsm, 0, sizeof(*pAsm));
+  pAsm->header = view.header;
 
-      return SA_UINT32_MAX;
-    }
+  sa_bool opcodeInFunction = SA_FALSE;
+  sa__assemblyInstruction_t inst;
 
-    if(arg[0] == '%') {
-      sa_uint32_t id = sa__getOrCreateSpirvId(pIds, arg + 1);
-      words[wordsSize - 1] = SA_CONVERT(id);
-    }
-    else if(sa__isStringInteger(arg)) {
-      sa_uint32_t value = sa__stringToInt(arg);
-      words[wordsSize - 1] = SA_CONVERT(value);
-    }
-    else if(sa__isStringFloat(arg)) {
-      float value = sa__stringToFloat(arg);
-      words[wordsSize - 1] = SA_CONVERT(*sa_ptr32(&value));
-    }
-    else if(arg[0] == '\"' && arg[sa__lengthString(arg) - 1] == '\"') {
-      char* buffer = (char*)sa_calloc(sa__lengthString(arg) - 1, sizeof(arg[0]));
-      if(!buffer) {
-        sa__errMsg("Cannot allocate memory for buffer");
+  // Operands are copied straight from binary into sections
+  while(sa_spirvViewNext(&view, &inst)) {
+    if(inst.opCode == saOp_Function)
+      opcodeInFunction = SA_TRUE;
 
-        return SA_UINT32_MAX;
-      }
-      sa__copyMemory(&arg[1], buffer, sa__lengthString(arg) - 2);
+    if(inst.opCode == saOp_FunctionEnd)
+      opcodeInFunction = SA_FALSE;
 
-      for(sa_uint32_t j = 0; j < ((sa__lengthString(buffer) + 1) + 3) / sizeof(sa_uint32_t); j++) {
-        if(wordsSize > (minimalWordCount - 1)) {
-          words = (sa_uint32_t*)sa_realloc(words, wordsSize * sizeof(sa_uint32_t));
-          words[wordsSize - 1] = 0;
-        }
-        
-        if(!words) {
-          sa__errMsg("Cannot reallocate memory for words");
-          
-          return SA_UINT32_MAX;
-        }
+    sa__addInstruction(pCtx, pAsm, opcodeInFunction ? saSectionType_Functions : sa__getOperandSectionType(inst.opCode), inst.wordSize, inst.opCode, inst.words);
+  }
 
-        sa_uint32_t tmpWord = 0;
+  if(view.malformed)
+    sa__errMsg(pCtx, saDiagnostic_MalformedInstruction, "Malformed instruction at word %d\n", view.offset);
+}
 
-        for(sa_uint32_t k = 0; k < 4; k++) {
-          if((j * 4 + k) <= sa__lengthString(buffer))
-            tmpWord |= ((sa_uint32_t)buffer[j * 4 + k]) << (8 * k);
-          else
-            break;
-        }
+#ifndef SA_NO_FILE_IO
 
-        words[wordsSize - 1] = SA_CONVERT(tmpWord);
+//
+// File input
+//
 
-        wordsSize++;
-      }
+// Smaller files are read, mapping and unmapping them costs more than copy
+#define SA_MAP_FILE_MIN_SIZE 65536
+
+// Read only file contents, either mapped or read into memory when mapping is not possible (pipes, empty files)
+typedef struct sa__fileView_s {
+  const sa_uint8_t* pData;
+  sa_uint32_t size;
+  sa_bool mapped;
+#ifdef SA_FILE_IO_WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+} sa__fileView_t;
 
-      wordsSize--;
+/**
+ * @brief Reads rest of file into memory, used when file cannot be mapped
+ * 
+ * @param pCtx 
+ * @param pView view to fill, pData is allocated with sa_malloc
+ * @param readFn reads up to size bytes into pBuffer, returns amount read, 0 at the end and negative on error
+ * @param pUserData passed to readFn
+ * @param sizeHint expected file size, 0 when unknown
+ * @param path for error message
+ * @return sa_bool 
+ */
+static sa_bool sa__readFileView(sa_context_t* pCtx, sa__fileView_t* pView, long (*readFn)(void* pUserData, sa_uint8_t* pBuffer, sa_uint32_t size), void* pUserData, sa_uint32_t sizeHint, const char* path) {
+  sa_uint32_t capacity = 0;
+  sa_uint32_t size = 0;
+  // One byte more than expected, so end of file is seen without growing
+  sa_uint8_t* pData = (sa_uint8_t*)sa__growArray(SA_NULL, sizeof(sa_uint8_t), &capacity, sizeHint + 1, SA_NULL);
 
-      sa_free(buffer);
-      buffer = SA_NULL;
-    }
-    else {
-      sa_uint32_t enumerant = sa__getLowLevelInstructionEnum(instructionIndex, arg);
+  for(;;) {
+    // growArray doubles, so growing is amortized for pipes of unknown size
+    if(size == capacity)
+      pData = (sa_uint8_t*)sa__growArray(pData, sizeof(sa_uint8_t), &capacity, size + 65536, SA_NULL);
 
-      words[wordsSize - 1] = SA_CONVERT(enumerant);
+    const long readSize = readFn(pUserData, &pData[size], capacity - size);
 
-      if(operand == saOp_EntryPoint) {
-        sa_uint32_t capability = 0;
+    if(readSize < 0) {
+      sa_free(pData);
+      sa__errMsg(pCtx, saDiagnostic_File, "Cannot read file %s", path);
 
-        switch (enumerant) {
-        case saEntryPoint_Vertex:
-        case saEntryPoint_Fragment:
-        case saEntryPoint_GLCompute:
-          capability = saCapability_Shader;
+      return SA_FALSE;
+    }
 
-          break;
+    if(readSize == 0)
+      break;
 
-        case saEntryPoint_TessellationControl:
-        case saEntryPoint_TessellationEvaluation:
-          capability = saCapability_Tesselation;
+    if((sa_uint32_t)readSize > SA_UINT32_MAX - 65536 - size) {
+      sa_free(pData);
+      sa__errMsg(pCtx, saDiagnostic_File, "File %s is too big", path);
 
-          break;
+      return SA_FALSE;
+    }
 
-        case saEntryPoint_Geometry:
-          capability = saCapability_Geometry;
-          
-          break;
-        }
+    size += (sa_uint32_t)readSize;
+  }
 
-        if(capability)
-          sa__addInstruction(&pAssembly->section[saSectionType_Capability], 2, saOp_Capability, &capability);
-      }
+  pView->pData = pData;
+  pView->size = size;
+  pView->mapped = SA_FALSE;
 
-      if(enumerant == SA_UINT32_MAX) {
-        sa__errMsg("Wrong enumerant for %s: %s @ line %d", sa__opcodeToString(operand), arg, line);
+  return SA_TRUE;
+}
 
-        return SA_UINT32_MAX;
-      }
-    }
-  }
-  
-  sa_uint32_t operandSection = sa__getOperandSectionType(operand);
-  sa_bool canBeInsideFunction = SA_TRUE;
+#if defined(SA_FILE_IO_POSIX)
+static long sa__readFileDescriptor(void* pUserData, sa_uint8_t* pBuffer, sa_uint32_t size) {
+  const int fd = *(const int*)pUserData;
+  ssize_t readSize;
 
-  if(operandSection == saSectionType_Types && operand != saOp_Variable && operand != saOp_Line && operand != saOp_Undef) {
-    canBeInsideFunction = SA_FALSE;
-  }
+  // Signals can interrupt read before anything was read
+  do {
+    readSize = read(fd, pBuffer, size);
+  } while(readSize < 0 && errno == EINTR);
 
-  if(canBeInsideFunction && *pInsideFn)
-    operandSection = saSectionType_Functions;
+  return (long)readSize;
+}
+#elif defined(SA_FILE_IO_WIN32)
+static long sa__readFileHandle(void* pUserData, sa_uint8_t* pBuffer, sa_uint32_t size) {
+  DWORD readSize = 0;
 
-  // Add instruction
-  sa__addInstruction(&pAssembly->section[operandSection], wordsSize + 1, operand, words);
+  if(!ReadFile(*(HANDLE*)pUserData, pBuffer, size, &readSize, SA_NULL))
+    return -1;
 
-  sa_free(words);
-  words = SA_NULL;
+  return (long)readSize;
+}
+#else
+static long sa__readFileStream(void* pUserData, sa_uint8_t* pBuffer, sa_uint32_t size) {
+  FILE* file = (FILE*)pUserData;
+  const size_t readSize = fread(pBuffer, 1, size, file);
 
-  for(sa_uint32_t i = 0; i < argsCounter; i++) {
-    sa_free(allArgs[i]);
-    allArgs[i] = SA_NULL;
-  }
-  
-  sa_free(allArgs);
-  allArgs = SA_NULL;
+  if(readSize == 0 && ferror(file))
+    return -1;
 
-  return p - spirvAssemblyStrStart;
+  return (long)readSize;
 }
+#endif
 
 /**
- * @brief Return code as a pointer
+ * @brief Opens file read only. Regular files of at least SA_MAP_FILE_MIN_SIZE bytes are mapped, everything else is read
  * 
- * @param spirvBasicAssembly text to process
- * @param pCodeSizeOut assembled code size
- * @return sa_uint32_t* Assembled code
+ * @param pCtx 
+ * @param path 
+ * @param pView view to fill, close with sa__closeFileView
+ * @return sa_bool SA_FALSE if file cannot be opened or read, error is added to context
  */
-static void sa_assembleSPIRV(const char* spirvBasicAssembly, sa_assembly_t* pAssembly) {  
-  sa__resetId();
-  sa__clearErrorMessages();
+static sa_bool sa__openFileView(sa_context_t* pCtx, const char* path, sa__fileView_t* pView) {
+  pCtx = sa__resolveContext(pCtx);
 
-  sa_uint32_t index = 0;
+  sa__setMemory(pView, 0, sizeof(*pView));
 
-  sa__spirvIdTable_t ids = {0};
-  sa_bool insideFn = SA_FALSE;
-  sa_uint32_t line = 1;
+#if defined(SA_FILE_IO_POSIX)
+  int fd;
 
-  const sa_uint32_t spirvSize = sa__lengthString(spirvBasicAssembly);
-  char* strippedSpirv = (char*)sa_calloc(spirvSize, sizeof(char));
-  sa_uint32_t strippedSpirvSize = 0;
+  do {
+    fd = open(path, O_RDONLY);
+  } while(fd < 0 && errno == EINTR);
 
-  for(sa_uint32_t i = 0; i < spirvSize; i++) {
-    if(spirvBasicAssembly[i] != '\r') { 
-      strippedSpirv[strippedSpirvSize] = spirvBasicAssembly[i];
-      strippedSpirvSize++;
-    }
+  if(fd < 0) {
+    sa__errMsg(pCtx, saDiagnostic_File, "Cannot open file %s", path);
+
+    return SA_FALSE;
   }
 
-  strippedSpirv = (char*)sa_realloc(strippedSpirv, (strippedSpirvSize + 1) * sizeof(char));
+  struct stat info;
+  sa_uint32_t sizeHint = 0;
 
-  sa_uint32_t memoryModelWords[2] = {saAddresingModel_Logical, saMemoryModel_Vulkan};
-  sa__addInstruction(&pAssembly->section[saSectionType_MemoryModel], 3, saOp_MemoryModel, memoryModelWords);
+  if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+    if((sa_uint64_t)info.st_size > SA_UINT32_MAX - 65536) {
+      close(fd);
+      sa__errMsg(pCtx, saDiagnostic_File, "File %s is too big", path);
 
-  while(strippedSpirv[index]) {
-    sa_uint32_t next = sa__parseLowLevelInstruction(&strippedSpirv[index], pAssembly, &ids, &insideFn, line);
+      return SA_FALSE;
+    }
 
-    if(next == SA_UINT32_MAX) {
-      while(strippedSpirv[index] != '\n')
-        index++;
-      
-      index++;
+    sizeHint = (sa_uint32_t)info.st_size;
+  }
 
-      //sa__errMsg("Something went wrong @ line %d", line);
+  if(sizeHint >= SA_MAP_FILE_MIN_SIZE) {
+    void* pMapped = mmap(SA_NULL, sizeHint, PROT_READ, MAP_PRIVATE, fd, 0);
 
-      //return;
-    }
+    if(pMapped != MAP_FAILED) {
+      // Mapping holds its own reference to the file
+      close(fd);
 
-    if(next != SA_UINT32_MAX) {
-      index += next;
-    }
+#ifdef MADV_SEQUENTIAL
+      madvise(pMapped, sizeHint, MADV_SEQUENTIAL);
+#endif
 
-    line++;
+      pView->pData = (const sa_uint8_t*)pMapped;
+      pView->size = sizeHint;
+      pView->mapped = SA_TRUE;
+
+      return SA_TRUE;
+    }
   }
 
-  pAssembly->header.bounds = ids.idCount + 1;
+  const sa_bool result = sa__readFileView(pCtx, pView, sa__readFileDescriptor, &fd, sizeHint, path);
 
-  for(sa_uint32_t i = 0; i < ids.idCount; i++) {
-    if(ids.pIds[i].textId[0] != '%') {
-      // +3 to add 1 more uint if there is not equal amount of bytes
-      const sa_uint32_t wordSize = (((sa__lengthString(ids.pIds[i].textId) + 1) + 3) / sizeof(sa_uint32_t)) + 1;
-      // Allocate for string and 1 uint32 value for id
-      sa_uint32_t* words = (sa_uint32_t*)sa_malloc(wordSize * sizeof(sa_uint32_t));
-      sa__setMemory(words, 0, wordSize / sizeof(sa_uint32_t));
-
-      words[0] = ids.pIds[i].binaryId;
-
-      // -1 for already added binaryId
-      for(sa_uint32_t j = 1; j < wordSize; j++) {
-        words[j] =
-          ((((sa_uint32_t)ids.pIds[i].textId[(j - 1) * 4 + 3]) << 24) & 0xFF000000) | 
-          ((((sa_uint32_t)ids.pIds[i].textId[(j - 1) * 4 + 2]) << 16) & 0x00FF0000) | 
-          ((((sa_uint32_t)ids.pIds[i].textId[(j - 1) * 4 + 1]) << 8) & 0x0000FF00) |
-          ((((sa_uint32_t)ids.pIds[i].textId[(j - 1) * 4 + 0]) << 0) & 0x000000FF);
-      }
+  close(fd);
 
-      // Word size needs to account operand, so +1
-      sa__addInstruction(&pAssembly->section[sa__getOperandSectionType(saOp_Name)], wordSize + 1, saOp_Name, &words[0]);
+  return result;
+#elif defined(SA_FILE_IO_WIN32)
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, SA_NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, SA_NULL);
 
-      sa_free(words);
-      words = SA_NULL;
-    }
+  if(file == INVALID_HANDLE_VALUE) {
+    sa__errMsg(pCtx, saDiagnostic_File, "Cannot open file %s", path);
+
+    return SA_FALSE;
   }
 
-  sa_free(strippedSpirv);
-  strippedSpirv = SA_NULL;
-  strippedSpirvSize = 0;
+  LARGE_INTEGER fileSize;
+  sa_uint32_t sizeHint = 0;
 
-  sa__freeSpirvIdTable(&ids);
-}
+  if(GetFileType(file) == FILE_TYPE_DISK && GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+    if((sa_uint64_t)fileSize.QuadPart > SA_UINT32_MAX - 65536) {
+      CloseHandle(file);
+      sa__errMsg(pCtx, saDiagnostic_File, "File %s is too big", path);
 
-/**
- * @brief Bakes assembly into actual binary data
- * 
- * @param pAssembly assembly to bake
- * @param pBinarySizeOut size of binary table 
- * @return sa_binary pointer to binary data itself
- */
-static sa_uint8_t* sa_bakeSPIRV(const sa_assembly_t* const pAssembly, sa_uint32_t* pBinarySizeOut) {
-  if(!pAssembly) {
-    sa__errMsg("No assembly");
+      return SA_FALSE;
+    }
 
-    return SA_NULL;
+    sizeHint = (sa_uint32_t)fileSize.QuadPart;
   }
 
-  if(!pBinarySizeOut) {
-    sa__errMsg("No size output");
+  if(sizeHint >= SA_MAP_FILE_MIN_SIZE) {
+    HANDLE mapping = CreateFileMappingA(file, SA_NULL, PAGE_READONLY, 0, 0, SA_NULL);
+    const void* pMapped = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : SA_NULL;
 
-    return SA_NULL;
-  }
+    if(pMapped) {
+      pView->pData = (const sa_uint8_t*)pMapped;
+      pView->size = sizeHint;
+      pView->mapped = SA_TRUE;
+      pView->file = file;
+      pView->mapping = mapping;
 
-  sa_uint8_t* sbin = (sa_uint8_t*)sa_malloc(sizeof(sa__assemblyHeader_t));
-  sa_uint32_t sbinSize = (sizeof(sa__assemblyHeader_t) / sizeof(sa_uint32_t));
-  
-  sa__clearErrorMessages();
+      return SA_TRUE;
+    }
 
-  // Always converted to little endian
-  sa_ptr32(sbin)[0] = SA_CONVERT(SA_SPIRV_MAGIC_NUMBER);
-  sa_ptr32(sbin)[1] = SA_CONVERT(SA_SPIRV_VERSION);
-  sa_ptr32(sbin)[2] = SA_CONVERT(SA_SPIRV_GENERATOR_ID);
-  sa_ptr32(sbin)[3] = SA_CONVERT(pAssembly->header.bounds);
-  sa_ptr32(sbin)[4] = SA_CONVERT(pAssembly->header.schema);
+    if(mapping)
+      CloseHandle(mapping);
+  }
 
-  for(sa_uint32_t sectId = 0; sectId < saSectionType_COUNT; sectId++) {
-    const sa__assemblySection_t* const pSect = &pAssembly->section[sectId];
+  const sa_bool result = sa__readFileView(pCtx, pView, sa__readFileHandle, &file, sizeHint, path);
 
-    for(sa_uint32_t instId = 0; instId < pSect->instCount; instId++) {
-      const sa_uint32_t instStart = sbinSize;
-      const sa__assemblyInstruction_t* const pInst = &pSect->pInst[instId];
+  CloseHandle(file);
 
-      sbinSize += pInst->wordSize;
-      sbin = (sa_uint8_t*)sa_realloc(sbin, sbinSize * sizeof(sa_uint32_t));
+  return result;
+#else
+  FILE* file = fopen(path, "rb");
 
-      sa_ptr32(sbin)[instStart + 0] = SA_CONVERT((((sa_uint32_t)pInst->wordSize) << 16) | pInst->opCode);
+  if(!file) {
+    sa__errMsg(pCtx, saDiagnostic_File, "Cannot open file %s", path);
 
-      sa__copyMemory(pInst->words, &sa_ptr32(sbin)[instStart + 1], (pInst->wordSize - 1) * sizeof(sa_uint32_t));
-    }
+    return SA_FALSE;
   }
 
-  *pBinarySizeOut = sbinSize * sizeof(sa_uint32_t);
+  const sa_bool result = sa__readFileView(pCtx, pView, sa__readFileStream, file, 0, path);
 
-  return sbin;
+  fclose(file);
+
+  return result;
+#endif
+}
+
+static void sa__closeFileView(sa__fileView_t* pView) {
+  if(pView->mapped) {
+#if defined(SA_FILE_IO_POSIX)
+    munmap((void*)pView->pData, pView->size);
+#elif defined(SA_FILE_IO_WIN32)
+    UnmapViewOfFile(pView->pData);
+    CloseHandle(pView->mapping);
+    CloseHandle(pView->file);
+#endif
+  }
+  else if(pView->pData) {
+    sa_free((void*)pView->pData);
+  }
+
+  sa__setMemory(pView, 0, sizeof(*pView));
 }
 
 /**
- * @brief disassemble SPIR-V shader
+ * @brief Assembles .spa file, text is parsed straight from mapped file without copying it
  * 
- * @param shaderBin 
- * @param shaderSize size must be as a amount of elements inside SPIR-V in 32bit format (so read file length / sizeof(int))
+ * @param pCtx context, SA_NULL for default one
+ * @param path path to .spa file
+ * @param pAssembly assembly to fill
+ * @return sa_bool SA_FALSE if file cannot be opened or read, assembly errors are only reported in context
  */
-static void sa_disassembleSPIRV(sa_assembly_t* pAsm, sa_uint8_t* shaderBin, sa_uint32_t shaderSize) {
-  sa_uint32_t index = 0;
+static sa_bool sa_assembleFile(sa_context_t* pCtx, const char* path, sa_assembly_t* pAssembly) {
+  pCtx = sa__resolveContext(pCtx);
 
-  sa__clearErrorMessages();
+  sa__clearDiagnostics(&pCtx->diagnostics);
 
-  sa__setMemory(pAsm, 0, sizeof(*pAsm));
+  sa__fileView_t view;
 
-  if(SA_CONVERT(sa_ptr32(shaderBin)[0]) != SA_SPIRV_MAGIC_NUMBER) {
-    sa__errMsg("SPIR-V Magic number does not match file magic number!\n");
+  if(!sa__openFileView(pCtx, path, &view))
+    return SA_FALSE;
 
-    return;
-  }
+  sa_assembleSPIRVN(pCtx, (const char*)view.pData, view.size, pAssembly);
 
-  pAsm->header.magic = SA_CONVERT(sa_ptr32(shaderBin)[0]);
-  pAsm->header.version = SA_CONVERT(sa_ptr32(shaderBin)[1]);
-  pAsm->header.generator = SA_CONVERT(sa_ptr32(shaderBin)[2]);
-  pAsm->header.bounds = SA_CONVERT(sa_ptr32(shaderBin)[3]);
-  pAsm->header.schema = SA_CONVERT(sa_ptr32(shaderBin)[4]);
-  // Advance index by 5 to skip header
-  index += 5;
+  sa__closeFileView(&view);
 
-  sa_bool opcodeInFunction = SA_FALSE;
+  return SA_TRUE;
+}
 
-  for(; index < shaderSize; index++) {
-    // This contain opcode and word count
-    sa_uint32_t word = SA_CONVERT(sa_ptr32(shaderBin)[index]);
+/**
+ * @brief Disassembles .spv file, words are read straight from mapped file
+ * 
+ * @param pCtx context, SA_NULL for default one
+ * @param path path to .spv file
+ * @param pAsm assembly to fill, same as in sa_disassembleSPIRV it is not freed first
+ * @return sa_bool SA_FALSE if file cannot be opened, read or is not made of whole words, disassembly errors are only reported in context
+ */
+static sa_bool sa_disassembleFile(sa_context_t* pCtx, const char* path, sa_assembly_t* pAsm) {
+  pCtx = sa__resolveContext(pCtx);
 
-    // Mask off LSB as this is still in LE, then convert
-    sa_uint16_t opcode = word & 0x0000FFFF;
-    sa_uint16_t wordCount = (word >> 16) & 0x0000FFFF;
+  sa__clearDiagnostics(&pCtx->diagnostics);
 
-    // Add all words
-    sa_uint32_t* words = (sa_uint32_t*)sa_calloc(wordCount - 1, sizeof(sa_uint32_t));
+  sa__fileView_t view;
 
-    if(opcode == saOp_Function)
-      opcodeInFunction = SA_TRUE;
+  if(!sa__openFileView(pCtx, path, &view))
+    return SA_FALSE;
 
-    if(opcode == saOp_FunctionEnd)
-      opcodeInFunction = SA_FALSE;
+  // Mapped and allocated memory are page or malloc aligned, this only guards against odd platforms
+  if(view.size % sizeof(sa_uint32_t) != 0 || (size_t)view.pData % sizeof(sa_uint32_t) != 0) {
+    sa__errMsg(pCtx, saDiagnostic_File, "File %s is not made of whole SPIR-V words (%u bytes)", path, view.size);
+    sa__closeFileView(&view);
 
-    for(sa_uint32_t i = 0; i < wordCount - 1; i++) {
-      index++;
-      words[i] = SA_CONVERT(sa_ptr32(shaderBin)[index]);
-    }
+    return SA_FALSE;
+  }
 
-    // Make instruction
-    sa__addInstruction(&pAsm->section[opcodeInFunction ? saSectionType_Functions : sa__getOperandSectionType(opcode)], wordCount, opcode, words);
+  sa_disassembleSPIRV(pCtx, pAsm, (sa_uint8_t*)view.pData, view.size / sizeof(sa_uint32_t));
 
-    // Free temp garbage
-    sa_free(words);
-    words = SA_NULL;
-  }
+  sa__closeFileView(&view);
+
+  return SA_TRUE;
 }
 
 #endif
+
+#endif
@@ -3,16 +3,19 @@
 #include <stdio.h>
 
 static void printAssembly(sa_assembly_t* pAsm) {
-  sa__spirvIdTable_t ids = { SA_NULL, 0 };
+  sa__spirvIdTable_t ids = {0};
+  sa__reserveSpirvIdBounds(&ids, pAsm->header.bounds);
 
   for(sa_uint32_t sect = 0; sect < saSectionType_COUNT; sect++) {
     for(sa_uint32_t i = 0; i < pAsm->section[sect].instCount; i++) {
-      if(pAsm->section[sect].pInst[i].opCode == saOp_Name || pAsm->section[sect].pInst[i].opCode == saOp_ExtInstImport) {
+      sa__assemblyInstruction_t inst = sa__getInstruction(&pAsm->section[sect], i);
+
+      if(inst.opCode == saOp_Name || inst.opCode == saOp_ExtInstImport) {
         char name[512] = {0};
         sa_uint32_t nameSize = 0;
 
-        for(sa_uint32_t j = 1; j < pAsm->section[sect].pInst[i].wordSize; j++) {
-          sa_uint32_t name4b = pAsm->section[sect].pInst[i].words[j];
+        for(sa_uint32_t j = 1; j < inst.wordSize; j++) {
+          sa_uint32_t name4b = inst.words[j];
 
           name[nameSize++] = sa_ptr8(&name4b)[0];
           name[nameSize++] = sa_ptr8(&name4b)[1];
@@ -20,7 +23,7 @@ static void printAssembly(sa_assembly_t* pAsm) {
           name[nameSize++] = sa_ptr8(&name4b)[3];
         }
 
-        sa__createSpirvNameId(&ids, name, pAsm->section[sect].pInst[i].words[0]);
+        sa__createSpirvNameId(&ids, name, inst.words[0]);
       }
     }
   }
@@ -29,20 +32,22 @@ static void printAssembly(sa_assembly_t* pAsm) {
     printf("\nSection %s:\n", sa__sectionToString(sect));
 
     for(sa_uint32_t i = 0; i < pAsm->section[sect].instCount; i++) {
-      //if(pAsm->section[sect].pInst[i].opCode == saOp_Name || 
-      //  pAsm->section[sect].pInst[i].opCode == saOp_Source ||
-      //  pAsm->section[sect].pInst[i].opCode == saOp_SourceExtension ||
-      //  pAsm->section[sect].pInst[i].opCode == saOp_SourceContinued ||
-      //  pAsm->section[sect].pInst[i].opCode == saOp_MemberName ||
-      //  pAsm->section[sect].pInst[i].opCode == saOp_MemoryModel ||
-      //  pAsm->section[sect].pInst[i].opCode == saOp_Capability
+      sa__assemblyInstruction_t inst = sa__getInstruction(&pAsm->section[sect], i);
+
+      //if(inst.opCode == saOp_Name || 
+      //  inst.opCode == saOp_Source ||
+      //  inst.opCode == saOp_SourceExtension ||
+      //  inst.opCode == saOp_SourceContinued ||
+      //  inst.opCode == saOp_MemberName ||
+      //  inst.opCode == saOp_MemoryModel ||
+      //  inst.opCode == saOp_Capability
       //)
       //  continue;
 
-      printf("%s ", sa__opcodeToString(pAsm->section[sect].pInst[i].opCode));
+      printf("%s ", sa__opcodeToString(inst.opCode));
       
-      for(sa_uint32_t j = 0; j < pAsm->section[sect].pInst[i].wordSize - 1; j++) {
-        sa_uint32_t word = pAsm->section[sect].pInst[i].words[j];
+      for(sa_uint32_t j = 0; j < inst.wordSize - 1; j++) {
+        sa_uint32_t word = inst.words[j];
         const char* name = sa__getSpirvName(&ids, word);
         if(name != SA_NULL) {
           printf("%%%s ", name);
@@ -99,7 +104,7 @@ const char* tokToStr(sa_uint32_t tok) {
 
 void printLex(sa_lexer_t* pLex) {
   for(sa_uint32_t i = 0; i < pLex->tokenCount; i++) {
-    printf("%s | %s\n", tokToStr(pLex->pTokens[i].token), pLex->pTokens[i].tokenId);
+    printf("%s | %s\n", tokToStr(pLex->pTokens[i].token), sa__lexerText(pLex, &pLex->pTokens[i]));
   }
 } 
 
@@ -110,39 +115,36 @@ void saveBin(const char* filename, void* bin, sa_uint32_t binSize) {
 }
 
 int main() {
-  FILE* spirv = fopen("../example1.sba", "rb");
+  sa__fileView_t spirv;
 
-  if(!spirv) {
-    printf("[ERROR]: Cannot open spirv shader!\n");
+  if(!sa__openFileView(sa_defaultContext(), "../example1.sba", &spirv)) {
+    printf("[ERROR]: %s\n", sa_diagnosticMessage(&sa_defaultContext()->diagnostics, 0));
     
     return 0;
   }
 
-  fseek(spirv, 0, SEEK_END);
-  int length = ftell(spirv);
-  fseek(spirv, 0, SEEK_SET);
-
-  sa_uint8_t* spirvBin = (sa_uint8_t*)calloc(length + 1, sizeof(sa_int8_t));
-  fread(spirvBin, sizeof(sa_uint8_t), length, spirv);
-
-  fclose(spirv);
-
-  printf("%s\n", spirvBin);
+  printf("%.*s\n", (int)spirv.size, (const char*)spirv.pData);
 
   sa_lexer_t spaLex;
-  sa_lexSPIRV(spirvBin, &spaLex);
+  sa_lexSPIRVN((const char*)spirv.pData, spirv.size, &spaLex);
 
   printLex(&spaLex);
 
-  /*sa_assembly_t sasm = {0};
-  sa_assembleSPIRV(spirvBin, &sasm);
+  sa_freeLexer(&spaLex);
+  sa__closeFileView(&spirv);
+
+  /*sa_context_t ctx;
+  sa_initContext(&ctx);
+
+  sa_assembly_t sasm = {0};
+  sa_assembleFile(&ctx, "../test_comp.spa", &sasm);
 
-  for(sa_uint32_t i = 0; i < __gAssemblerErrorMessages.messagesAmount; i++) {
-    printf("[ERROR]: %s\n", __gAssemblerErrorMessages.pMessages[i]);
+  for(sa_uint32_t i = 0; i < ctx.diagnostics.recordCount; i++) {
+    printf("[ERROR]: %s\n", sa_diagnosticMessage(&ctx.diagnostics, i));
   }
 
   sa_uint32_t binarySize = 0;
-  sa_uint8_t* binary = sa_bakeSPIRV(&sasm, &binarySize);
+  sa_uint8_t* binary = sa_bakeSPIRV(&ctx, &sasm, &binarySize);
 
   printf("Binary size: %d\n", binarySize);
 
@@ -154,19 +156,18 @@ int main() {
 
   //printAssembly(&sasm);
   sa_freeAssembly(&sasm);
-  free(spirvBin);*/
+  sa_freeContext(&ctx);*/
 
-  /*sa_assembly_t spvasm;
-  sa_disassembleSPIRV(&spvasm, spirvBin, length / sizeof(sa_uint32_t));
+  /*sa_assembly_t spvasm = {0};
+  sa_disassembleFile(SA_NULL, "../test_comp.spv", &spvasm);
 
-  for(sa_uint32_t i = 0; i < __gAssemblerErrorMessages.messagesAmount; i++) {
-    printf("%s", __gAssemblerErrorMessages.pMessages[i]);
+  for(sa_uint32_t i = 0; i < sa_defaultContext()->diagnostics.recordCount; i++) {
+    printf("%s", sa_diagnosticMessage(&sa_defaultContext()->diagnostics, i));
   }
 
   printAssembly(&spvasm);
 
-  sa_freeAssembly(&spvasm);
-  free(spirvBin);*/
+  sa_freeAssembly(&spvasm);*/
 
   return 0;
 }
\ No newline at end of file
@@ -53,13 +53,16 @@ typedef enum sa__TokenType_e {
 
 // TODO: Lexer for SBA
 typedef struct sa__token_t {
-  char tokenId[512];
+  // Handle to the token text in sa_lexer_t::strings
+  sa_uint32_t tokenId;
   sa__TokenType_t token;
 } sa__token_t;
 
 typedef struct sa_lexer_s {
   sa__token_t* pTokens;
   sa_uint32_t tokenCount;
+  sa_uint32_t tokenCapacity;
+  sa__stringPool_t strings;
 } sa_lexer_t;
 
 typedef struct sa__lexerKeywordConnection_s {
@@ -97,16 +100,33 @@ const sa__lexerKeywordConnection_t __gsaSBAKeywords[] = {
   { "null", saToken_Null },
 };
 
-const char __gsaSBAOperators[] = "+-*/=%^&|!~";
-const char __gsaSBAPunctuators[] = "[]{}(),.:;";
-
-static void sa__lexerAddToken(sa_lexer_t* pLexer, sa__TokenType_t token, const char* text, sa_uint32_t textSize) {
+static void sa__lexerAddToken(sa_lexer_t* pLexer, sa__TokenType_t token, sa_uint32_t textHandle) {
   pLexer->tokenCount++;  
-  pLexer->pTokens = (sa__token_t*)sa_realloc(pLexer->pTokens, pLexer->tokenCount * sizeof(sa__token_t));
+  pLexer->pTokens = (sa__token_t*)sa__growArray(pLexer->pTokens, sizeof(sa__token_t), &pLexer->tokenCapacity, pLexer->tokenCount, SA_NULL);
 
   pLexer->pTokens[pLexer->tokenCount - 1].token = token;
-  sa__setMemory(pLexer->pTokens[pLexer->tokenCount - 1].tokenId, 0, sizeof(pLexer->pTokens[pLexer->tokenCount - 1].tokenId));
-  sa__copyMemory(text, pLexer->pTokens[pLexer->tokenCount - 1].tokenId, textSize);
+  pLexer->pTokens[pLexer->tokenCount - 1].tokenId = textHandle;
+}
+
+/**
+ * @brief Pre-sizes token list
+ * 
+ * @param pLexer 
+ * @param tokenCount 
+ */
+static void sa__lexerReserve(sa_lexer_t* pLexer, sa_uint32_t tokenCount) {
+  pLexer->pTokens = (sa__token_t*)sa__growArray(pLexer->pTokens, sizeof(sa__token_t), &pLexer->tokenCapacity, tokenCount, SA_NULL);
+}
+
+/**
+ * @brief Gets text of a token, pointer is valid until lexer adds another token
+ * 
+ * @param pLexer 
+ * @param pToken 
+ * @return const char* 
+ */
+static const char* sa__lexerText(const sa_lexer_t* pLexer, const sa__token_t* pToken) {
+  return sa__poolString(&pLexer->strings, pToken->tokenId);
 }
 
 static void sa_freeLexer(sa_lexer_t* pLexer) {
@@ -114,24 +134,17 @@ static void sa_freeLexer(sa_lexer_t* pLexer) {
     sa_free(pLexer->pTokens);
   pLexer->pTokens = SA_NULL;
   pLexer->tokenCount = 0;
+  pLexer->tokenCapacity = 0;
+
+  sa__freeStringPool(&pLexer->strings);
 }
 
 static sa_bool sa__lexerCheckPunctuator(char c) {
-  for(sa_uint32_t i = 0; i < sa__lengthString(__gsaSBAPunctuators); i++) {
-    if(__gsaSBAPunctuators[i] == c)
-      return SA_TRUE;
-  }
-
-  return SA_FALSE;
+  return (SA_CHAR_CLASS[(sa_uint8_t)c] & SA_CHAR_PUNCTUATOR) != 0;
 }
 
 static sa_bool sa__lexerCheckOperator(char c) {
-  for(sa_uint32_t i = 0; i < sa__lengthString(__gsaSBAOperators); i++) {
-    if(__gsaSBAOperators[i] == c)
-      return SA_TRUE;
-  }
-
-  return SA_FALSE;
+  return (SA_CHAR_CLASS[(sa_uint8_t)c] & SA_CHAR_OPERATOR) != 0;
 }
 
 static sa_uint32_t sa__lexerCheckKeyword(const char* kw) {
@@ -152,26 +165,24 @@ static sa_bool sa__lexerCheckLiteral(const char* literal, sa_uint32_t size) {
   return SA_TRUE;
 }
 
-static void sa__lexerAddKeyword(sa_lexer_t* pLexerData, sa__TokenType_t type, const char* text, sa_uint32_t textSize) {
-  sa__lexerAddToken(pLexerData, (sa__TokenType_t)type, text, textSize);
+static void sa__lexerAddKeyword(sa_lexer_t* pLexerData, sa__TokenType_t type, sa_uint32_t textHandle) {
+  sa__lexerAddToken(pLexerData, (sa__TokenType_t)type, textHandle);
 }
 
-static void sa__lexerAddIdentifier(sa_lexer_t* pLexerData, const char* text, sa_uint32_t textSize) {
-  sa__lexerAddToken(pLexerData, saToken_Identifier, text, textSize);
+static void sa__lexerAddIdentifier(sa_lexer_t* pLexerData, sa_uint32_t textHandle) {
+  sa__lexerAddToken(pLexerData, saToken_Identifier, textHandle);
 }
 
-static void sa__lexerAddLiteral(sa_lexer_t* pLexerData, const char* lit, sa_uint32_t litSize) {
-  sa__lexerAddToken(pLexerData, saToken_Literal, lit, litSize);
+static void sa__lexerAddLiteral(sa_lexer_t* pLexerData, sa_uint32_t litHandle) {
+  sa__lexerAddToken(pLexerData, saToken_Literal, litHandle);
 }
 
 static void sa__lexerAddPunctuator(sa_lexer_t* pLexerData, char punctuatorCh) {
-  char punc[2] = { punctuatorCh, 0 };
-  sa__lexerAddToken(pLexerData, saToken_Punctuator, punc, 2);
+  sa__lexerAddToken(pLexerData, saToken_Punctuator, sa__internString(&pLexerData->strings, &punctuatorCh, 1));
 }
 
 static void sa__lexerAddOperator(sa_lexer_t* pLexerData, char operatorCh) {
-  char op[2] = { operatorCh, 0 };
-  sa__lexerAddToken(pLexerData, saToken_Punctuator, op, 2);
+  sa__lexerAddToken(pLexerData, saToken_Punctuator, sa__internString(&pLexerData->strings, &operatorCh, 1));
 }
 
 static void sa__lexerAddAnything(sa_lexer_t* pLexerData, const char* start, const char* current) {
@@ -192,92 +203,97 @@ static void sa__lexerAddAnything(sa_lexer_t* pLexerData, const char* start, cons
     }
   }
 
-  char* textPart = (char*)sa_calloc(current - start + 1, sizeof(char));
-  sa__copyMemory(start, textPart, current - start);
+  // Pool gives null terminated copy, so there is no need for temporary buffer
+  sa_uint32_t textHandle = sa__internString(&pLexerData->strings, start, current - start);
+  const char* textPart = sa__poolString(&pLexerData->strings, textHandle);
 
   sa_uint32_t keyword = sa__lexerCheckKeyword(textPart);
 
   if(keyword != SA_UINT32_MAX)
-    sa__lexerAddKeyword(pLexerData, (sa__TokenType_t)keyword, textPart, current - start + 1);
+    sa__lexerAddKeyword(pLexerData, (sa__TokenType_t)keyword, textHandle);
   else if(sa__lexerCheckLiteral(textPart, current - start))
-    sa__lexerAddLiteral(pLexerData, textPart, current - start + 1); 
+    sa__lexerAddLiteral(pLexerData, textHandle); 
   else
-    sa__lexerAddIdentifier(pLexerData, textPart, current - start + 1);
-  
-  sa_free(textPart);
-  textPart = SA_NULL;
+    sa__lexerAddIdentifier(pLexerData, textHandle);
 }
 
-static void sa_lexSPIRV(const char* spirvBasicAssembly, sa_lexer_t* pLexerData) {
-  const sa_uint32_t sbaSize = sa__lengthString(spirvBasicAssembly); 
-  char* strippedSBA = (char*)sa_calloc(sbaSize, sizeof(char));
-  sa_uint32_t strippedSBASize = 0;
+/**
+ * @brief Splits SBA text slice into tokens, text does not need to be null terminated
+ * 
+ * @param spirvBasicAssembly text to process
+ * @param length length of text in bytes
+ * @param pLexerData lexer to fill, free with sa_freeLexer
+ */
+static void sa_lexSPIRVN(const char* spirvBasicAssembly, sa_uint32_t length, sa_lexer_t* pLexerData) {
+  sa__setMemory(pLexerData, 0, sizeof(*pLexerData));
+  // Rough guess of one token per 4 characters
+  sa__lexerReserve(pLexerData, length / 4 + 1);
+
+  const char* p = spirvBasicAssembly;
+  const char* const end = spirvBasicAssembly + length;
+  // Start of token that is currently read
+  const char* start = p;
+  // Character right after separator always starts a token, so sigils like %name stay one token
+  sa_bool tokenHead = SA_FALSE;
+  // Text is read front to back, so every block is classified once for all tokens in it
+  sa__textScanner_t scanner;
+
+  sa__initScanner(&scanner, end, SA_CHAR_WHITE | SA_CHAR_NEWLINE | SA_CHAR_PUNCTUATOR | SA_CHAR_OPERATOR | SA_CHAR_HASH);
+
+  while(p < end) {
+    const char c = *p;
+    const sa_uint8_t charClass = SA_CHAR_CLASS[(sa_uint8_t)c];
+
+    if(charClass & SA_CHAR_HASH) {
+      sa__lexerAddAnything(pLexerData, start, p);
 
-  pLexerData->tokenCount = 0;
-  pLexerData->pTokens = SA_NULL;
+      // Comment lasts until the end of line
+      p = sa__scanFind(&scanner, p, SA_CHAR_NEWLINE);
 
-  for(sa_uint32_t i = 0; i < sbaSize; i++) {
-    if(spirvBasicAssembly[i] != '\r' && spirvBasicAssembly[i] != '#') {
-      strippedSBA[strippedSBASize] = spirvBasicAssembly[i];
-      strippedSBASize++;
-    }
-    else if(spirvBasicAssembly[i] == '#') {
-      while(spirvBasicAssembly[i] != '\n')
-        i++;
+      start = p;
     }
-  }
-
-  strippedSBA = (char*)sa_realloc(strippedSBA, (strippedSBASize + 1) * sizeof(char));
-
-  char* p = &strippedSBA[0];
-  char* start = p;
-
-  while(*p) {
-    //  || sa__checkPunctuator(*p) || sa__checkOperator(*p)
-    if(*p == ' ' || *p == '\n' || *p == '\t') {
+    else if(charClass & (SA_CHAR_WHITE | SA_CHAR_NEWLINE)) {
       sa__lexerAddAnything(pLexerData, start, p);
 
-      p++;
+      p = sa__scanSkip(&scanner, p, SA_CHAR_WHITE | SA_CHAR_NEWLINE);
       start = p;
-
-      while(*start == ' ' || *start == '\t' || *start == '\n') {
-        start++;
-        p++;
-      }
+      tokenHead = SA_TRUE;
     }
-    else if(sa__lexerCheckPunctuator(*p)) {
-      char punc = *p;
-
+    else if(tokenHead || !charClass) {
+      // Rest of token is everything up to next separator
+      tokenHead = SA_FALSE;
+      p = sa__scanFind(&scanner, p + 1, SA_CHAR_WHITE | SA_CHAR_NEWLINE | SA_CHAR_PUNCTUATOR | SA_CHAR_OPERATOR | SA_CHAR_HASH);
+    }
+    else if(charClass & SA_CHAR_PUNCTUATOR) {
       sa__lexerAddAnything(pLexerData, start, p);
-      sa__lexerAddPunctuator(pLexerData, punc);
+      sa__lexerAddPunctuator(pLexerData, c);
 
       p++;
       start = p;
-
-      while(*start == ' ' || *start == '\t' || *start == '\n') {
-        start++;
-        p++;
-      }
+      tokenHead = SA_TRUE;
     }
-    else if(sa__lexerCheckOperator(*p)) {
-      char op = *p;
-
+    else {
       sa__lexerAddAnything(pLexerData, start, p);
-      sa__lexerAddOperator(pLexerData, op);
+      sa__lexerAddOperator(pLexerData, c);
 
       p++;
       start = p;
-
-      while(*start == ' ' || *start == '\t' || *start == '\n') {
-        start++;
-        p++;
-      }
+      tokenHead = SA_TRUE;
     }
-
-    p++;
   }
 
-  sa_free(strippedSBA);
+  // Last token does not need anything after it
+  sa__lexerAddAnything(pLexerData, start, p);
+}
+
+/**
+ * @brief Splits null terminated SBA text into tokens
+ * 
+ * @param spirvBasicAssembly text to process
+ * @param pLexerData lexer to fill, free with sa_freeLexer
+ */
+static void sa_lexSPIRV(const char* spirvBasicAssembly, sa_lexer_t* pLexerData) {
+  sa_lexSPIRVN(spirvBasicAssembly, sa__lengthString(spirvBasicAssembly), pLexerData);
 }
 
 /*
@@ -316,15 +332,15 @@ static sa_uint32_t* sa__sbaMakeStringIntoWords(const char* str, sa_uint32_t* pOu
   return words;
 }
 
-static void sa__sbaAddDebugVoidType(sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds) {
+static void sa__sbaAddDebugVoidType(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds) {
   if(sa__spirvIdNameExist(pIds, SA_SBA_DEBUG_VOIDT))
     return;
 
-  sa_uint32_t id = sa__getOrCreateSpirvId(pIds, SA_SBA_DEBUG_VOIDT);
-  sa__addInstruction(&pAssembly->section[saSectionType_Types], 2, saOp_TypeVoid, &id);
+  sa_uint32_t id = sa__getOrCreateSpirvId(pCtx, pIds, SA_SBA_DEBUG_VOIDT);
+  sa__addInstruction(pCtx, pAssembly, saSectionType_Types, 2, saOp_TypeVoid, &id);
 }
 
-static void sa__sbaAddName(sa_assembly_t* pAssembly, const char* name, sa_uint32_t id) {
+static void sa__sbaAddName(sa_context_t* pCtx, sa_assembly_t* pAssembly, const char* name, sa_uint32_t id) {
   // Make that full token name into uint32
   sa_uint32_t nameWordsSize = 0;
   sa_uint32_t* nameWords = sa__sbaMakeStringIntoWords(name, &nameWordsSize);
@@ -334,7 +350,7 @@ static void sa__sbaAddName(sa_assembly_t* pAssembly, const char* name, sa_uint32
   words[0] = id;
   sa__copyMemory(nameWords, &words[1], nameWordsSize * sizeof(sa_uint32_t));
 
-  sa__addInstruction(&pAssembly->section[saSectionType_Debug], nameWordsSize + 2, saOp_Name, words);
+  sa__addInstruction(pCtx, pAssembly, saSectionType_Debug, nameWordsSize + 2, saOp_Name, words);
   
   sa_free(nameWords);
   sa_free(words);
@@ -344,34 +360,34 @@ static void sa__sbaAddName(sa_assembly_t* pAssembly, const char* name, sa_uint32
 // SBA resolvers
 //
 
-static sa_uint32_t sa__sbaResolveModule(sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa__token_t* pStartingToken) {
+static sa_uint32_t sa__sbaResolveModule(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, const sa_lexer_t* pLexer, sa__token_t* pStartingToken) {
   if(pStartingToken[0].token == saToken_Module)
     return 0;
 
   if(pStartingToken[1].token == saToken_Identifier) {
-    sa__errMsg("Module needs identifier, found %s", pStartingToken[1].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Module needs identifier, found %s", sa__lexerText(pLexer, &pStartingToken[1]));
 
     return 0;
   }
 
   // Add debug void type
-  sa__sbaAddDebugVoidType(pAssembly, pIds);
+  sa__sbaAddDebugVoidType(pCtx, pAssembly, pIds);
 
   // Get id for that debug void
-  sa_uint32_t id = sa__getOrCreateSpirvId(pIds, SA_SBA_DEBUG_VOIDT);
+  sa_uint32_t id = sa__getOrCreateSpirvId(pCtx, pIds, SA_SBA_DEBUG_VOIDT);
 
   // Make full module token name 
-  const sa_uint32_t fullTokenSize = sa__lengthString(pStartingToken[1].tokenId) + sa__lengthString(SA_SBA_MODULE_NAME_PREFIX) + 1;
+  const sa_uint32_t fullTokenSize = sa__lengthString(sa__lexerText(pLexer, &pStartingToken[1])) + sa__lengthString(SA_SBA_MODULE_NAME_PREFIX) + 1;
   char* fullToken = (char*)sa_calloc(fullTokenSize, sizeof(char));
   sa__copyMemory(SA_SBA_MODULE_NAME_PREFIX, &fullToken[0], sa__lengthString(SA_SBA_MODULE_NAME_PREFIX));
-  sa__copyMemory(pStartingToken[1].tokenId, &fullToken[sa__lengthString(SA_SBA_MODULE_NAME_PREFIX)], sa__lengthString(pStartingToken[1].tokenId));
+  sa__copyMemory(sa__lexerText(pLexer, &pStartingToken[1]), &fullToken[sa__lengthString(SA_SBA_MODULE_NAME_PREFIX)], sa__lengthString(sa__lexerText(pLexer, &pStartingToken[1])));
 
-  sa__sbaAddName(pAssembly, fullToken, id);
+  sa__sbaAddName(pCtx, pAssembly, fullToken, id);
   
   sa_free(fullToken);
 
-  if(pStartingToken[2].token != saToken_Punctuator && pStartingToken[2].tokenId[0] != ';') {
-    sa__errMsg("You forgot semicolon (;) at the end of module %s", pStartingToken[1].tokenId);
+  if(pStartingToken[2].token != saToken_Punctuator && sa__lexerText(pLexer, &pStartingToken[2])[0] != ';') {
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "You forgot semicolon (;) at the end of module %s", sa__lexerText(pLexer, &pStartingToken[1]));
 
     return 2;
   }
@@ -379,20 +395,20 @@ static sa_uint32_t sa__sbaResolveModule(sa_assembly_t* pAssembly, sa__spirvIdTab
   return 3;
 }
 
-static sa_uint32_t sa__sbaResolveImport(sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa__token_t* pStartingToken) {
+static sa_uint32_t sa__sbaResolveImport(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, const sa_lexer_t* pLexer, sa__token_t* pStartingToken) {
   if(pStartingToken[0].token != saToken_Import)
     return 0;
 
   if(pStartingToken[1].token != saToken_Identifier || pStartingToken[2].token != saToken_Identifier) {
-    sa__errMsg("Values after import must be identifiers");
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Values after import must be identifiers");
 
     return 0;
   }
 
-  sa_uint32_t id = sa__getOrCreateSpirvId(pIds, &pStartingToken[1].tokenId[1]);
-  sa__sbaAddName(pAssembly, &pStartingToken[1].tokenId[1], id);
+  sa_uint32_t id = sa__getOrCreateSpirvId(pCtx, pIds, &sa__lexerText(pLexer, &pStartingToken[1])[1]);
+  sa__sbaAddName(pCtx, pAssembly, &sa__lexerText(pLexer, &pStartingToken[1])[1], id);
 
-  if(sa__compareString(SA_SBA_SPECIAL_IMPORT, pStartingToken[2].tokenId) == 0) {
+  if(sa__compareString(SA_SBA_SPECIAL_IMPORT, sa__lexerText(pLexer, &pStartingToken[2])) == 0) {
     sa_uint32_t nameWordsSize = 0;
     sa_uint32_t* nameWords = sa__sbaMakeStringIntoWords("GLSL.std.450", &nameWordsSize);
 
@@ -401,13 +417,13 @@ static sa_uint32_t sa__sbaResolveImport(sa_assembly_t* pAssembly, sa__spirvIdTab
     words[0] = id;
     sa__copyMemory(nameWords, &words[1], nameWordsSize * sizeof(sa_uint32_t));
 
-    sa__addInstruction(&pAssembly->section[saSectionType_Extensions], nameWordsSize + 2, saOp_ExtInstImport, words);
+    sa__addInstruction(pCtx, pAssembly, saSectionType_Extensions, nameWordsSize + 2, saOp_ExtInstImport, words);
 
     sa_free(words);
     sa_free(nameWords);
 
-    if(pStartingToken[3].token != saToken_Punctuator && pStartingToken[3].tokenId[0] != ';') {
-      sa__errMsg("You forgot semicolon (;) at the end of import %s", pStartingToken[1].tokenId);
+    if(pStartingToken[3].token != saToken_Punctuator && sa__lexerText(pLexer, &pStartingToken[3])[0] != ';') {
+      sa__errMsg(pCtx, saDiagnostic_Syntax, "You forgot semicolon (;) at the end of import %s", sa__lexerText(pLexer, &pStartingToken[1]));
       
       return 3;
     }
@@ -416,17 +432,17 @@ static sa_uint32_t sa__sbaResolveImport(sa_assembly_t* pAssembly, sa__spirvIdTab
   }
 
   // Make full import name
-  const sa_uint32_t fullTokenSize = sa__lengthString(pStartingToken[2].tokenId) + sa__lengthString(SA_SBA_IMPORT_MODULE_NAME_PREFIX) + 1;
+  const sa_uint32_t fullTokenSize = sa__lengthString(sa__lexerText(pLexer, &pStartingToken[2])) + sa__lengthString(SA_SBA_IMPORT_MODULE_NAME_PREFIX) + 1;
   char* fullToken = (char*)sa_calloc(fullTokenSize, sizeof(char));
   sa__copyMemory(SA_SBA_IMPORT_MODULE_NAME_PREFIX, &fullToken[0], sa__lengthString(SA_SBA_IMPORT_MODULE_NAME_PREFIX));
-  sa__copyMemory(pStartingToken[2].tokenId, &fullToken[sa__lengthString(SA_SBA_IMPORT_MODULE_NAME_PREFIX)], sa__lengthString(pStartingToken[2].tokenId));
+  sa__copyMemory(sa__lexerText(pLexer, &pStartingToken[2]), &fullToken[sa__lengthString(SA_SBA_IMPORT_MODULE_NAME_PREFIX)], sa__lengthString(sa__lexerText(pLexer, &pStartingToken[2])));
 
-  sa__sbaAddName(pAssembly, fullToken, id);
+  sa__sbaAddName(pCtx, pAssembly, fullToken, id);
 
   sa_free(fullToken);
 
-  if(pStartingToken[3].token != saToken_Punctuator && pStartingToken[3].tokenId[0] != ';') {
-    sa__errMsg("You forgot semicolon (;) at the end of import %s", pStartingToken[1].tokenId);
+  if(pStartingToken[3].token != saToken_Punctuator && sa__lexerText(pLexer, &pStartingToken[3])[0] != ';') {
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "You forgot semicolon (;) at the end of import %s", sa__lexerText(pLexer, &pStartingToken[1]));
     
     return 3;
   }
@@ -434,16 +450,17 @@ static sa_uint32_t sa__sbaResolveImport(sa_assembly_t* pAssembly, sa__spirvIdTab
   return 4;
 }
 
-static sa_uint32_t sa__sbaResolveEntryPoint(sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa__token_t* pStartingToken) {
+static sa_uint32_t sa__sbaResolveEntryPoint(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, const sa_lexer_t* pLexer, sa__token_t* pStartingToken) {
   // Check for entry
   if(pStartingToken[0].token != saToken_Entry)
     return 0;
 
   sa_uint32_t entryPointSize = 1;
-  sa_uint32_t* words = (sa_uint32_t*)sa_calloc(entryPointSize, sizeof(sa_uint32_t));
+  sa_uint32_t entryPointCapacity = 0;
+  sa_uint32_t* words = (sa_uint32_t*)sa__growArray(SA_NULL, sizeof(sa_uint32_t), &entryPointCapacity, entryPointSize, SA_NULL);
   
   // Check for token validity
-  words[0] = sa__getLowLevelInstructionEnum(saOp_EntryPoint, pStartingToken[1].tokenId); 
+  words[0] = sa__getLowLevelInstructionEnum(saOp_EntryPoint, sa__lexerText(pLexer, &pStartingToken[1]), sa__lengthString(sa__lexerText(pLexer, &pStartingToken[1]))); 
 
   sa_uint32_t capability = 0;
 
@@ -465,45 +482,45 @@ static sa_uint32_t sa__sbaResolveEntryPoint(sa_assembly_t* pAssembly, sa__spirvI
     break;
   }
 
-  sa__addInstruction(&pAssembly->section[saSectionType_Capability], 2, saOp_Capability, &capability);
+  sa__addInstruction(pCtx, pAssembly, saSectionType_Capability, 2, saOp_Capability, &capability);
 
   if(words[0] == SA_UINT32_MAX || pStartingToken[2].token != saToken_Identifier) {
-    sa__errMsg("Invalid shader type at entry: %s", pStartingToken[1].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Invalid shader type at entry: %s", sa__lexerText(pLexer, &pStartingToken[1]));
 
     return 0;
   }
 
   entryPointSize++;
-  words = (sa_uint32_t*)sa_realloc(words, entryPointSize * sizeof(sa_uint32_t));
-  sa_uint32_t fnId = sa__getOrCreateSpirvId(pIds, &pStartingToken[2].tokenId[1]);
+  words = (sa_uint32_t*)sa__growArray(words, sizeof(sa_uint32_t), &entryPointCapacity, entryPointSize, SA_NULL);
+  sa_uint32_t fnId = sa__getOrCreateSpirvId(pCtx, pIds, &sa__lexerText(pLexer, &pStartingToken[2])[1]);
   words[1] = fnId;
 
-  sa__sbaAddName(pAssembly, &pStartingToken[2].tokenId[1], fnId);
+  sa__sbaAddName(pCtx, pAssembly, &sa__lexerText(pLexer, &pStartingToken[2])[1], fnId);
 
   sa_uint32_t entryNameWordsSize = 0;
-  sa_uint32_t* entryNameWords = sa__sbaMakeStringIntoWords(&pStartingToken[2].tokenId[1], &entryNameWordsSize);
+  sa_uint32_t* entryNameWords = sa__sbaMakeStringIntoWords(&sa__lexerText(pLexer, &pStartingToken[2])[1], &entryNameWordsSize);
   entryPointSize += entryNameWordsSize;
 
-  words = (sa_uint32_t*)sa_realloc(words, entryPointSize * sizeof(sa_uint32_t));
+  words = (sa_uint32_t*)sa__growArray(words, sizeof(sa_uint32_t), &entryPointCapacity, entryPointSize, SA_NULL);
   sa__copyMemory(entryNameWords, &words[2], entryNameWordsSize);
   
   sa_uint32_t tokenCounter = 3;
   while(pStartingToken[tokenCounter].token == saToken_Identifier) {
     entryPointSize++;
-    words = (sa_uint32_t*)sa_realloc(words, entryPointSize * sizeof(sa_uint32_t));
-    sa_uint32_t argId = sa__getOrCreateSpirvId(pIds, &pStartingToken[tokenCounter].tokenId[1]);
+    words = (sa_uint32_t*)sa__growArray(words, sizeof(sa_uint32_t), &entryPointCapacity, entryPointSize, SA_NULL);
+    sa_uint32_t argId = sa__getOrCreateSpirvId(pCtx, pIds, &sa__lexerText(pLexer, &pStartingToken[tokenCounter])[1]);
     
     words[entryPointSize - 1] = argId;
 
     tokenCounter++;
   }
 
-  sa__addInstruction(&pAssembly->section[saSectionType_EntryPoints], entryPointSize + 1, saOp_EntryPoint, words);
+  sa__addInstruction(pCtx, pAssembly, saSectionType_EntryPoints, entryPointSize + 1, saOp_EntryPoint, words);
 
   sa_free(words);
 
-  if(pStartingToken[tokenCounter].token != saToken_Punctuator && pStartingToken[tokenCounter].tokenId[0] != ';') {
-    sa__errMsg("You forgot semicolon (;) at the end of entrypoint %s %s", pStartingToken[1].tokenId, pStartingToken[2].tokenId);
+  if(pStartingToken[tokenCounter].token != saToken_Punctuator && sa__lexerText(pLexer, &pStartingToken[tokenCounter])[0] != ';') {
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "You forgot semicolon (;) at the end of entrypoint %s %s", sa__lexerText(pLexer, &pStartingToken[1]), sa__lexerText(pLexer, &pStartingToken[2]));
     
     return tokenCounter;
   }
@@ -512,97 +529,98 @@ static sa_uint32_t sa__sbaResolveEntryPoint(sa_assembly_t* pAssembly, sa__spirvI
   return tokenCounter + 1;
 }
 
-static sa_uint32_t sa__sbaResolveExecutionMode(sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa__token_t* pStartingToken) {
+static sa_uint32_t sa__sbaResolveExecutionMode(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, const sa_lexer_t* pLexer, sa__token_t* pStartingToken) {
   if(pStartingToken[0].token != saToken_Execmode)
     return 0;
 
   if(pStartingToken[1].token != saToken_Identifier) {
-    sa__errMsg("Value after exec_mode must be identifier: %s", pStartingToken[1].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Value after exec_mode must be identifier: %s", sa__lexerText(pLexer, &pStartingToken[1]));
 
     return 0;
   }
 
   if(pStartingToken[2].token != saToken_Identifier) {
-    sa__errMsg("Execution mode must be a identifier: %s", pStartingToken[2].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Execution mode must be a identifier: %s", sa__lexerText(pLexer, &pStartingToken[2]));
   }
 
-  sa_uint32_t instEnum = sa__getLowLevelInstructionEnum(saOp_ExecutionMode, pStartingToken[2].tokenId);
+  sa_uint32_t instEnum = sa__getLowLevelInstructionEnum(saOp_ExecutionMode, sa__lexerText(pLexer, &pStartingToken[2]), sa__lengthString(sa__lexerText(pLexer, &pStartingToken[2])));
 
   if(instEnum == SA_UINT32_MAX) {
-    sa__errMsg("Invalid instruction enumerant (%s) for execution mode instruction", pStartingToken[2].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Invalid instruction enumerant (%s) for execution mode instruction", sa__lexerText(pLexer, &pStartingToken[2]));
 
     return 0;
   }
 
   sa_uint32_t instEnumIndex = 3;
 
-  sa_uint32_t* arguments = (sa_uint32_t*)sa_calloc(1, sizeof(sa_uint32_t));
+  sa_uint32_t argumentsCapacity = 0;
+  sa_uint32_t* arguments = (sa_uint32_t*)sa__growArray(SA_NULL, sizeof(sa_uint32_t), &argumentsCapacity, 1, SA_NULL);
 
-  while(pStartingToken[instEnumIndex].token != saToken_Punctuator && pStartingToken[instEnumIndex].tokenId[0] != ';') {
-    arguments = (sa_uint32_t*)sa_realloc(arguments, (instEnumIndex - 2) * sizeof(sa_uint32_t));
+  while(pStartingToken[instEnumIndex].token != saToken_Punctuator && sa__lexerText(pLexer, &pStartingToken[instEnumIndex])[0] != ';') {
+    arguments = (sa_uint32_t*)sa__growArray(arguments, sizeof(sa_uint32_t), &argumentsCapacity, instEnumIndex - 2, SA_NULL);
 
     if(pStartingToken[instEnumIndex].token == saToken_Literal)
-      arguments[instEnumIndex - 3] = sa__stringToInt(pStartingToken[instEnumIndex].tokenId);
+      arguments[instEnumIndex - 3] = sa__stringToInt(sa__lexerText(pLexer, &pStartingToken[instEnumIndex]), sa__lengthString(sa__lexerText(pLexer, &pStartingToken[instEnumIndex])));
 
     instEnumIndex++; 
   }
 
   sa_uint32_t* words = (sa_uint32_t*)sa_calloc(instEnumIndex - 1, sizeof(sa_uint32_t));
 
-  words[0] = sa__getOrCreateSpirvId(pIds, pStartingToken[1].tokenId);
+  words[0] = sa__getOrCreateSpirvId(pCtx, pIds, sa__lexerText(pLexer, &pStartingToken[1]));
   words[1] = instEnum;
   sa__copyMemory(arguments, words + 2, instEnumIndex - 2);
 
-  sa__addInstruction(&pAssembly->section[saSectionType_ExecutionModes], instEnumIndex - 1, saOp_ExecutionMode, words);
+  sa__addInstruction(pCtx, pAssembly, saSectionType_ExecutionModes, instEnumIndex - 1, saOp_ExecutionMode, words);
 
-  if(pStartingToken[instEnumIndex].tokenId[0] != ';')
+  if(sa__lexerText(pLexer, &pStartingToken[instEnumIndex])[0] != ';')
     return instEnumIndex;
 
   return instEnumIndex + 1;
 }
 
-static sa_uint32_t sa__sbaResolveUniform(sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa__token_t* pStartingToken) {
+static sa_uint32_t sa__sbaResolveUniform(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, const sa_lexer_t* pLexer, sa__token_t* pStartingToken) {
   if(pStartingToken[0].token != saToken_Uniform)
     return 0;
 
-  sa_uint32_t uniVarId = sa__getOrCreateSpirvId(pIds, pStartingToken[1].tokenId);
+  sa_uint32_t uniVarId = sa__getOrCreateSpirvId(pCtx, pIds, sa__lexerText(pLexer, &pStartingToken[1]));
 
   if(uniVarId == SA_UINT32_MAX) {
-    sa__errMsg("Cannot create name/id for uniform of name %s", pStartingToken[1].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Cannot create name/id for uniform of name %s", sa__lexerText(pLexer, &pStartingToken[1]));
 
     return 0;
   }
 
-  sa_uint32_t uniTypeId = sa__getSpirvId(pIds, pStartingToken[2].tokenId);
+  sa_uint32_t uniTypeId = sa__getSpirvId(pIds, sa__lexerText(pLexer, &pStartingToken[2]));
 
   if(uniTypeId == SA_UINT32_MAX) {
-    sa__errMsg("Non existing type for uniform: %s", pStartingToken[2].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Non existing type for uniform: %s", sa__lexerText(pLexer, &pStartingToken[2]));
 
     return 0;
   }
   // TODO: Add uni
-  //sa__addInstruction(pAssembly->section[], sa_uint16_t wordSize, sa_uint16_t op, sa_uint32_t *words);
+  //sa__addInstruction(pCtx, pAssembly, section, sa_uint16_t wordSize, sa_uint16_t op, sa_uint32_t *words);
  
   // TODO: skip ';', tables
   return 3;
 }
 
-static sa_uint32_t sa__sbaResolveInput(sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, sa__token_t* pStartingToken) {
+static sa_uint32_t sa__sbaResolveInput(sa_context_t* pCtx, sa_assembly_t* pAssembly, sa__spirvIdTable_t* pIds, const sa_lexer_t* pLexer, sa__token_t* pStartingToken) {
   if(pStartingToken[0].token != saToken_Input)
     return 0;
 
-  sa_uint32_t inVarId = sa__getOrCreateSpirvId(pIds, pStartingToken[1].tokenId);
+  sa_uint32_t inVarId = sa__getOrCreateSpirvId(pCtx, pIds, sa__lexerText(pLexer, &pStartingToken[1]));
 
   if(inVarId == SA_UINT32_MAX) {
-    sa__errMsg("Cannot create name/id for input with name: %s", pStartingToken[1].tokenId); 
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Cannot create name/id for input with name: %s", sa__lexerText(pLexer, &pStartingToken[1])); 
 
     return 0;
   }
 
-  sa_uint32_t inTypeId = sa__getSpirvId(pIds, pStartingToken[2].tokenId);
+  sa_uint32_t inTypeId = sa__getSpirvId(pIds, sa__lexerText(pLexer, &pStartingToken[2]));
 
   if(inTypeId == SA_UINT32_MAX) {
-    sa__errMsg("Non existing type for input: %s", pStartingToken[2].tokenId);
+    sa__errMsg(pCtx, saDiagnostic_Syntax, "Non existing type for input: %s", sa__lexerText(pLexer, &pStartingToken[2]));
 
     return 0;
   }
@@ -611,7 +629,9 @@ static sa_uint32_t sa__sbaResolveInput(sa_assembly_t* pAssembly, sa__spirvIdTabl
   return 3;
 }
 
-static void sa_assembleSBA(const char* sbaSource, sa_assembly_t* pAssembly) {
+static void sa_assembleSBA(sa_context_t* pCtx, const char* sbaSource, sa_assembly_t* pAssembly) {
+  pCtx = sa__resolveContext(pCtx);
+
   sa__spirvIdTable_t ids;
 
   sa_lexer_t lex;
@@ -620,7 +640,7 @@ static void sa_assembleSBA(const char* sbaSource, sa_assembly_t* pAssembly) {
   sa__token_t* tok = lex.pTokens;
 
   sa_uint32_t memoryModelWords[2] = {saAddresingModel_Logical, saMemoryModel_Vulkan};
-  sa__addInstruction(&pAssembly->section[saSectionType_MemoryModel], 3, saOp_MemoryModel, memoryModelWords);
+  sa__addInstruction(pCtx, pAssembly, saSectionType_MemoryModel, 3, saOp_MemoryModel, memoryModelWords);
 
   for(sa_uint32_t i = 0; i < lex.tokenCount; i++) {
 